@@ -0,0 +1,42 @@
+#ifndef CPSWITHSPLINES_BENCHMARKUTILITIES_H
+#define CPSWITHSPLINES_BENCHMARKUTILITIES_H
+
+#include "../main/main.hpp"
+#include <chrono>
+#include <functional>
+
+std::vector<cv::Point> getBenchmarkContour(int sampleSize);
+double timeBenchmark(const std::function<void()>& run, int repetitions = 3);
+
+
+/**
+ * Synthetic closed contour with sampleSize points: a star-like shape, so the distances are not all alike.
+ */
+std::vector<cv::Point> getBenchmarkContour(int sampleSize) {
+    std::vector<cv::Point> contour;
+    for(int i = 0; i < sampleSize; i++) {
+        double t = 2 * CV_PI * i / sampleSize;
+        double r = 1000 + 300 * cos(5 * t) + 50 * sin(17 * t);
+        contour.push_back(cv::Point((int)round(2000 + r * cos(t)), (int)round(2000 + r * sin(t))));
+    }
+    return contour;
+}
+
+/**
+ * Best wall time, in milliseconds, of the given number of runs.
+ */
+double timeBenchmark(const std::function<void()>& run, int repetitions) {
+    double best = -1;
+    for(int r = 0; r < repetitions; r++) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        run();
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        if(best < 0 || elapsed.count() < best) {
+            best = elapsed.count();
+        }
+    }
+    return best;
+}
+
+
+#endif //CPSWITHSPLINES_BENCHMARKUTILITIES_H
@@ -0,0 +1,17 @@
+
+#include "cpsScalingBenchmark.hpp"
+#include "normLpBenchmark.hpp"
+#include "visibilityBenchmark.hpp"
+#include "matchingBenchmark.hpp"
+
+int main() {
+
+    cpsScalingBenchmark();
+    normLpBenchmark();
+    visibilityBenchmark();
+    geodesicBenchmark();
+    l2MatchingBenchmark();
+    coarseToFineBenchmark();
+    orientationBenchmark();
+
+}
@@ -0,0 +1,48 @@
+#ifndef CPSWITHSPLINES_CPSSCALINGBENCHMARK_H
+#define CPSWITHSPLINES_CPSSCALINGBENCHMARK_H
+
+#include "benchmarkUtilities.hpp"
+#include "../main/tiledCps.hpp"
+
+void cpsScalingBenchmark();
+
+
+/**
+ * Time computeCps against computeCpsTiled (in memory and streamed) for large sample counts and several thread counts.
+ * The ratio column is tiled / computeCps; with one thread it must not be above 1.
+ */
+void cpsScalingBenchmark() {
+    int sizes[] = {2048, 4096, 8192};
+    int threadCounts[] = {1, 2, 4, 8, 0};
+
+    std::cout << std::endl << "CPS construction scaling (ms)" << std::endl;
+    std::cout << "n\tthreads\tcomputeCps\ttiled\tratio\tstreamed" << std::endl;
+
+    for(int s = 0; s < 3; s++) {
+        int n = sizes[s];
+        std::vector<cv::Point> contour = getBenchmarkContour(n);
+        const double area = sqrt(contourArea(contour));
+
+        /* the original builder keeps two n x n matrices and uses a single thread, time it only once*/
+        double reference = -1;
+        if(n <= 4096) {
+            reference = timeBenchmark([&]() { computeCps(contour, area); });
+        }
+
+        for(int t = 0; t < 5; t++) {
+            int threads = getCpsThreadCount(threadCounts[t]);
+            double tiled = timeBenchmark([&]() { computeCpsTiled(contour, area, threads); });
+
+            double checksum = 0;
+            double streamed = timeBenchmark([&]() {
+                streamCpsTiled(contour, area, [&](int i, const real_t* row, int length) { checksum += row[i % length]; }, threads);
+            });
+
+            std::cout << n << "\t" << threads << "\t" << reference << "\t" << tiled << "\t"
+                      << (reference > 0 ? tiled / reference : -1) << "\t" << streamed << std::endl;
+        }
+    }
+}
+
+
+#endif //CPSWITHSPLINES_CPSSCALINGBENCHMARK_H
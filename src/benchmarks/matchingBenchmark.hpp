@@ -0,0 +1,200 @@
+#ifndef CPSWITHSPLINES_MATCHINGBENCHMARK_H
+#define CPSWITHSPLINES_MATCHINGBENCHMARK_H
+
+#include "benchmarkUtilities.hpp"
+#include "../main/cpsFunctions.hpp"
+
+cpsMatch naiveL2Matching(const CpsRows& mta, const CpsRows& mtb);
+void l2MatchingBenchmark();
+std::vector<cv::Point> getDeformedContour(const std::vector<cv::Point>& contour, int shift, int noise, unsigned seed);
+void coarseToFineBenchmark();
+void orientationBenchmark();
+
+
+/**
+ * The euclidean matching as a plain loop (the reference): for every rotation k and row i, the distance between row i
+ * of mta and row (i+k)%n of mtb, element by element. O(n^3) scalar work.
+ */
+cpsMatch naiveL2Matching(const CpsRows& mta, const CpsRows& mtb) {
+    int n = mta.rows();
+    cpsMatch result;
+    result.rotationIndex = 0;
+    result.cost = 0;
+    result.mirrored = false;
+    for(int k = 0; k < n; k++) {
+        CompensatedSum cost;
+        for(int i = 0; i < n; i++) {
+            const real_t* a = mta.row(i);
+            const real_t* b = mtb.row((i + k) % n);
+            real_t sum = 0;
+            for(int j = 0; j < n; j++) {
+                sum += (a[j] - b[j]) * (a[j] - b[j]);
+            }
+            cost.add(std::sqrt(sum));
+        }
+        if(k == 0 || cost.sum < result.cost) {
+            result.rotationIndex = k;
+            result.cost = cost.sum;
+        }
+    }
+    return result;
+}
+
+/**
+ * Time the euclidean matching of two signatures with the naive loop and with CpsMatcher::matchL2 (one matrix product
+ * and the cyclic diagonals), for n = 64 ... 1024. The second contour is the first one starting n/5 points later, so
+ * both must find the rotation n/5; the relative difference of the costs is reported.
+ */
+void l2MatchingBenchmark() {
+    std::cout << std::endl << "L2 matching (ms)" << std::endl;
+    std::cout << "n\tnaive\tGEMM\trotation (naive/GEMM)\trelative difference" << std::endl;
+
+    CpsMatcher matcher;
+    for(int n = 64; n <= 1024; n *= 2) {
+        std::vector<cv::Point> contour = getBenchmarkContour(n);
+        std::vector<cv::Point> shifted(contour.begin() + n / 5, contour.end());
+        shifted.insert(shifted.end(), contour.begin(), contour.begin() + n / 5);
+        cspResult A = computeCps(contour, 10);
+        cspResult B = computeCps(shifted, 10);
+
+        int repetitions = n <= 256 ? 3 : 1;
+        cpsMatch naive, gemm;
+        double naiveTime = timeBenchmark([&]() { naive = naiveL2Matching(A.CPSMatrix, B.CPSMatrix); }, repetitions);
+        double gemmTime = timeBenchmark([&]() { gemm = matcher.matchL2(A.CPSMatrix, B.CPSMatrix); }, repetitions);
+
+        double difference = std::abs(gemm.cost - naive.cost) / std::max(naive.cost, 1e-300);
+        std::cout << n << "\t" << naiveTime << "\t" << gemmTime << "\t" << naive.rotationIndex << "/"
+                  << gemm.rotationIndex << "\t" << difference << std::endl;
+    }
+}
+
+/**
+ * The contour starting shift points later, with every point moved by up to noise pixels on each axis (a fixed
+ * pseudo-random sequence for each seed).
+ */
+std::vector<cv::Point> getDeformedContour(const std::vector<cv::Point>& contour, int shift, int noise, unsigned seed) {
+    int n = contour.size();
+    std::vector<cv::Point> deformed;
+    for(int i = 0; i < n; i++) {
+        seed = seed * 1103515245u + 12345u;
+        int dx = (int)((seed >> 16) % (2 * noise + 1)) - noise;
+        seed = seed * 1103515245u + 12345u;
+        int dy = (int)((seed >> 16) % (2 * noise + 1)) - noise;
+        deformed.push_back(contour[(i + shift) % n] + cv::Point(dx, dy));
+    }
+    return deformed;
+}
+
+/**
+ * Time the exhaustive matching (CpsMatcher::match) against the coarse to fine search, with and without its exact
+ * check, over all the pairs of a set of deformed copies of a contour, and report how often the search alone found
+ * the best rotation.
+ */
+void coarseToFineBenchmark() {
+    std::cout << std::endl << "Coarse to fine matching (ms)" << std::endl;
+    std::cout << "n\tpairs\texhaustive\tcoarse to fine\texact\tagreement" << std::endl;
+
+    CpsMatcher matcher;
+    CoarseToFineOptions fast, exact;
+    exact.exact = true;
+    for(int n = 64; n <= 256; n *= 2) {
+        std::vector<cv::Point> contour = getBenchmarkContour(n);
+        std::vector<cspResult> signatures;
+        for(int s = 0; s < 8; s++) {
+            signatures.push_back(computeCps(getDeformedContour(contour, s * n / 8 + s, 4 * s, s + 1), 10));
+        }
+        int pairs = signatures.size() * signatures.size();
+
+        std::vector<cpsMatch> exhaustive, coarse;
+        double exhaustiveTime = timeBenchmark([&]() {
+            exhaustive.clear();
+            for(int a = 0; a < signatures.size(); a++) {
+                for(int b = 0; b < signatures.size(); b++) {
+                    exhaustive.push_back(matcher.match(signatures[a].CPSMatrix, signatures[b].CPSMatrix));
+                }
+            }
+        }, 1);
+        double coarseTime = timeBenchmark([&]() {
+            coarse.clear();
+            for(int a = 0; a < signatures.size(); a++) {
+                for(int b = 0; b < signatures.size(); b++) {
+                    coarse.push_back(matcher.matchCoarseToFine(signatures[a].CPSMatrix, signatures[b].CPSMatrix, fast));
+                }
+            }
+        }, 1);
+        matcher.resetCoarseToFineStatistics();
+        int mismatches = 0;
+        double exactTime = timeBenchmark([&]() {
+            for(int a = 0; a < signatures.size(); a++) {
+                for(int b = 0; b < signatures.size(); b++) {
+                    cpsMatch match = matcher.matchCoarseToFine(signatures[a].CPSMatrix, signatures[b].CPSMatrix, exact);
+                    const cpsMatch& expected = exhaustive[a * signatures.size() + b];
+                    mismatches += match.rotationIndex != expected.rotationIndex || match.cost != expected.cost;
+                }
+            }
+        }, 1);
+
+        int agreed = 0;
+        for(int p = 0; p < pairs; p++) {
+            agreed += coarse[p].rotationIndex == exhaustive[p].rotationIndex;
+        }
+        std::cout << n << "\t" << pairs << "\t" << exhaustiveTime << "\t" << coarseTime << "\t" << exactTime
+                  << (mismatches > 0 ? " (mismatch)" : "") << "\t" << (double)agreed / pairs << " / "
+                  << matcher.coarseToFineStatistics().agreement() << std::endl;
+    }
+}
+
+/**
+ * Time the matching of both contour orientations: two exhaustive matches, against the signature and against the one
+ * of the reversed contour, built by the caller, versus a single CpsMatcher::matchBothOrientations with the mirrors
+ * built once per signature, and the ratio of the latter to the early abandon matching of one orientation
+ * (CpsMatcher::matchEarlyAbandon). Half of the deformed
+ * copies are traced in the opposite direction; the winning orientation must be found for all of them.
+ */
+void orientationBenchmark() {
+    std::cout << std::endl << "Matching both orientations (ms)" << std::endl;
+    std::cout << "n\tpairs\ttwo matches\tone pass\tone orientation (early abandon)\tratio\twrong orientation"
+              << std::endl;
+
+    CpsMatcher matcher;
+    for(int n = 64; n <= 256; n *= 2) {
+        std::vector<cv::Point> contour = getBenchmarkContour(n);
+        cspResult A = computeCps(contour, 10);
+        std::vector<cspResult> signatures, reversed;
+        std::vector<CpsRows> mirrors(8);
+        for(int s = 0; s < 8; s++) {
+            std::vector<cv::Point> deformed = getDeformedContour(contour, s * n / 8 + s, 2 * s, s + 1);
+            if(s % 2) {
+                std::reverse(deformed.begin(), deformed.end());
+            }
+            signatures.push_back(computeCps(deformed, 10));
+            reversed.push_back(computeCps(std::vector<cv::Point>(deformed.rbegin(), deformed.rend()), 10));
+            signatures.back().CPSMatrix.mirror(mirrors[s]);
+        }
+
+        double twoTime = timeBenchmark([&]() {
+            for(int s = 0; s < signatures.size(); s++) {
+                matcher.match(A.CPSMatrix, signatures[s].CPSMatrix);
+                matcher.match(A.CPSMatrix, reversed[s].CPSMatrix);
+            }
+        });
+        int wrong = 0;
+        double oneTime = timeBenchmark([&]() {
+            wrong = 0;
+            for(int s = 0; s < signatures.size(); s++) {
+                wrong += matcher.matchBothOrientations(A.CPSMatrix, signatures[s].CPSMatrix, mirrors[s]).mirrored !=
+                         (s % 2 == 1);
+            }
+        });
+        double singleTime = timeBenchmark([&]() {
+            for(int s = 0; s < signatures.size(); s++) {
+                matcher.matchEarlyAbandon(A.CPSMatrix, signatures[s].CPSMatrix);
+            }
+        });
+        std::cout << n << "\t" << signatures.size() << "\t" << twoTime << "\t" << oneTime << "\t" << singleTime << "\t"
+                  << oneTime / singleTime << "\t" << wrong << std::endl;
+    }
+}
+
+
+#endif //CPSWITHSPLINES_MATCHINGBENCHMARK_H
@@ -0,0 +1,97 @@
+#ifndef CPSWITHSPLINES_NORMLPBENCHMARK_H
+#define CPSWITHSPLINES_NORMLPBENCHMARK_H
+
+#include "benchmarkUtilities.hpp"
+#include <NormLp.hpp>
+#include <NormL2.hpp>
+
+template<unsigned int P> double powNormLp(double x, double y);
+template<unsigned int P> void normLpBenchmarkRow(const std::vector<cv::Point>& contour);
+void normLpBenchmark();
+
+
+/**
+ * The lp-norm as Math.hpp computed it before the integer powers, three std::pow calls per vector (the reference).
+ */
+template<unsigned int P>
+double powNormLp(double x, double y) {
+    const double q = 1.0 / P;
+    double cx = std::abs(x), cy = std::abs(y);
+    return std::pow(std::pow(cx, (double)P) + std::pow(cy, (double)P), q);
+}
+
+/**
+ * Time all the pairwise lp distances of a contour with the reference and with cvx::NormLp_<P>, and report the
+ * largest relative difference between both.
+ */
+template<unsigned int P>
+void normLpBenchmarkRow(const std::vector<cv::Point>& contour) {
+    int n = contour.size();
+    std::vector<real_t> xs(n), ys(n), reference(n), current(n);
+    for(int i = 0; i < n; i++) {
+        xs[i] = contour[i].x;
+        ys[i] = contour[i].y;
+    }
+    cvx::NormLp_<P> norm;
+    double checksum = 0;
+
+    double powTime = timeBenchmark([&]() {
+        for(int i = 0; i < n; i++) {
+            for(int j = 0; j < n; j++) {
+                reference[j] = powNormLp<P>(xs[j] - xs[i], ys[j] - ys[i]);
+            }
+            checksum += reference[i % n];
+        }
+    });
+    double intTime = timeBenchmark([&]() {
+        for(int i = 0; i < n; i++) {
+            norm.batch(xs[i], ys[i], &xs[0], &ys[0], &current[0], n);
+            checksum += current[i % n];
+        }
+    });
+
+    double maxError = 0;
+    for(int i = 0; i < n; i += 17) {
+        norm.batch(xs[i], ys[i], &xs[0], &ys[0], &current[0], n);
+        for(int j = 0; j < n; j++) {
+            double expected = powNormLp<P>(xs[j] - xs[i], ys[j] - ys[i]);
+            if(expected > 0) {
+                maxError = std::max(maxError, std::abs(current[j] - expected) / expected);
+            }
+        }
+    }
+
+    std::cout << "L" << P << "\t" << n << "\t" << powTime << "\t" << intTime << "\t" << maxError << std::endl;
+}
+
+/**
+ * Time the lp distances with the former std::pow implementation against the integer powers and specialized roots.
+ * The L2 distance of the same contour is given as a baseline.
+ */
+void normLpBenchmark() {
+    int n = 4096;
+    std::vector<cv::Point> contour = getBenchmarkContour(n);
+
+    std::cout << std::endl << "Lp distances (ms)" << std::endl;
+    std::cout << "norm\tn\tstd::pow\tinteger\tmax relative error" << std::endl;
+
+    normLpBenchmarkRow<3>(contour);
+    normLpBenchmarkRow<4>(contour);
+    normLpBenchmarkRow<6>(contour);
+
+    std::vector<real_t> xs(n), ys(n), out(n);
+    for(int i = 0; i < n; i++) {
+        xs[i] = contour[i].x;
+        ys[i] = contour[i].y;
+    }
+    cvx::NormL2 l2;
+    double l2Time = timeBenchmark([&]() {
+        for(int i = 0; i < n; i++) {
+            l2.batch(xs[i], ys[i], &xs[0], &ys[0], &out[0], n);
+        }
+    });
+    std::cout << "L2\t" << n << "\t-\t" << l2Time << "\t-" << std::endl;
+}
+
+
+#endif //CPSWITHSPLINES_NORMLPBENCHMARK_H
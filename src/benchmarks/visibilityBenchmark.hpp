@@ -0,0 +1,76 @@
+#ifndef CPSWITHSPLINES_VISIBILITYBENCHMARK_H
+#define CPSWITHSPLINES_VISIBILITYBENCHMARK_H
+
+#include "benchmarkUtilities.hpp"
+#include "../main/geodesicCps.hpp"
+#include <DistanceInnerL2.hpp>
+
+void visibilityBenchmark();
+void geodesicBenchmark();
+
+
+/**
+ * Time the line-of-sight check of all the point pairs of a contour, and the inner-visibility cps built on it.
+ */
+void visibilityBenchmark() {
+    int sizes[] = {64, 128, 256};
+
+    std::cout << std::endl << "Inner visibility (ms)" << std::endl;
+    std::cout << "n\tmask\tall pairs\tvisible\tcomputeCps L2\tcomputeCps inner L2" << std::endl;
+
+    for(int s = 0; s < 3; s++) {
+        int n = sizes[s];
+        std::vector<cv::Point> contour = getBenchmarkContour(n);
+        const double area = sqrt(contourArea(contour));
+
+        cvx::PlanarSet shape;
+        double maskTime = timeBenchmark([&]() { shape = getContourShape(contour); });
+        cvx::DistanceInnerL2 inner(cvx::ConnectorLineOfSight(std::move(shape)));
+
+        int visible = 0;
+        double pairsTime = timeBenchmark([&]() {
+            visible = 0;
+            for(int i = 0; i < n; i++) {
+                for(int j = 0; j < n; j++) {
+                    visible += inner.connected(contour[i], contour[j]);
+                }
+            }
+        });
+
+        double flatTime = timeBenchmark([&]() { computeCps(contour, area, cvx::DistanceL2()); });
+        double innerTime = timeBenchmark([&]() { computeCps(contour, area, inner); });
+
+        std::cout << n << "\t" << maskTime << "\t" << pairsTime << "\t" << (double)visible / (n * n) << "\t"
+                  << flatTime << "\t" << innerTime << std::endl;
+    }
+}
+
+/**
+ * Time the geodesic cps, one fast marching sweep per row, on a single thread and on all of them.
+ * The benchmark contour is scaled down to a quarter, around 600 x 600 pixels.
+ */
+void geodesicBenchmark() {
+    int sizes[] = {64, 128, 256};
+
+    std::cout << std::endl << "Geodesic cps (ms)" << std::endl;
+    std::cout << "n	pixels	1 thread	all threads" << std::endl;
+
+    for(int s = 0; s < 3; s++) {
+        int n = sizes[s];
+        std::vector<cv::Point> contour = getBenchmarkContour(n);
+        for(int i = 0; i < n; i++) {
+            contour[i] = contour[i] * 0.25;
+        }
+        const double area = sqrt(contourArea(contour));
+        cvx::PlanarSet shape = getContourShape(contour);
+
+        double single = timeBenchmark([&]() { computeGeodesicCps(contour, area, shape, 1); }, 1);
+        double all = timeBenchmark([&]() { computeGeodesicCps(contour, area, shape); }, 1);
+
+        std::cout << n << "\t" << shape.count(cv::Rect(shape.origin(), cv::Size(shape.width(), shape.height())))
+                  << "\t" << single << "\t" << all << std::endl;
+    }
+}
+
+
+#endif //CPSWITHSPLINES_VISIBILITYBENCHMARK_H
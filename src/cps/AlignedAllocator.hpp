@@ -0,0 +1,171 @@
+/**
+ * @file        AlignedAllocator.hpp
+ *
+ * @brief       Defines an allocator for over-aligned contiguous storage,
+ *              suitable for aligned SIMD loads and stores.
+ *
+ * This file is part of The Computer Vision Tools Project. It is subject to the
+ * license terms in the [LICENSE.md](../license/LICENSE.md) file found in the
+ * `licenses` sub-folder of the top-level directory of this distribution and at
+ * https://bitbucket.org/cpslccauna/CPSignature/license/LICENSE.md. No part of
+ * this project, including this file, may be copied, modified, propagated, or
+ * distributed except according to the terms contained in the above LICENSE
+ * file.
+ *
+ * See the [COPYING.md](../COPYING.md) file at the top-level directory of this
+ * distribution and at https://bitbucket.org/cpslccauna/CPSignature/COPYING.md
+ * for more legal information.
+ */
+
+#ifndef CVX_UTIL_ALIGNED_ALLOCATOR_HPP__INCLUDED
+#define CVX_UTIL_ALIGNED_ALLOCATOR_HPP__INCLUDED
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <utility>
+
+
+/**
+ * @brief  Alignment, in bytes, of the contiguous storage of this library. It
+ *         is the size of a cache line, and of an AVX-512 register.
+ */
+#define CVX_ALIGNMENT 64
+
+
+namespace cvx {
+
+    /**
+     * @tclass      AlignedAllocator_< * >
+     *
+     * @brief       Class template for over-aligned allocators.
+     *
+     * @details     Objects of classes instantiated from this class template
+     *              allocate storage aligned to `Alignment` bytes, so it can
+     *              be used as the allocator of standard containers.
+     *
+     * @tparam      Type  The element type.
+     *
+     * @tparam      Alignment  The alignment, a power of two.
+     *
+     * @version     1.0
+     */
+    template< typename Type, size_t Alignment = CVX_ALIGNMENT >
+    class AlignedAllocator_ {
+
+    public:
+
+        typedef Type value_type;
+        typedef Type* pointer;
+        typedef const Type* const_pointer;
+        typedef Type& reference;
+        typedef const Type& const_reference;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+
+        template< typename Other >
+        struct rebind {
+            typedef AlignedAllocator_< Other, Alignment > other;
+        };
+
+
+    public:
+
+        /**
+         * @brief      Default constructor.
+         */
+        AlignedAllocator_() {
+            // NOOP
+        }
+
+
+        /**
+         * @brief      Converting constructor.
+         */
+        template< typename Other >
+        AlignedAllocator_(const AlignedAllocator_< Other, Alignment >&) {
+            // NOOP
+        }
+
+
+        /**
+         * @brief       Allocates storage for `n` elements.
+         *
+         * @details     The block is over-allocated, and the address of the
+         *              underlying allocation is kept just before the
+         *              aligned address returned.
+         */
+        pointer allocate(const size_type n) {
+            if (n > (std::numeric_limits< size_type >::max() - Alignment - sizeof(void*)) / sizeof(Type)) {
+                throw std::bad_alloc();
+            }
+            void* raw = ::operator new(n * sizeof(Type) + Alignment + sizeof(void*));
+            const uintptr_t base = reinterpret_cast< uintptr_t > (raw) + sizeof(void*);
+            const uintptr_t aligned = (base + Alignment - 1) & ~(uintptr_t) (Alignment - 1);
+            reinterpret_cast< void** > (aligned)[-1] = raw;
+            return reinterpret_cast< pointer > (aligned);
+        }
+
+
+        /**
+         * @brief       Releases storage returned by `allocate()`.
+         */
+        void deallocate(const pointer p, const size_type) {
+            if (p != 0) {
+                ::operator delete(reinterpret_cast< void** > (p)[-1]);
+            }
+        }
+
+
+        /**
+         * @brief       Returns the largest number of elements that can be
+         *              allocated.
+         */
+        size_type max_size() const {
+            return (std::numeric_limits< size_type >::max() - Alignment - sizeof(void*)) / sizeof(Type);
+        }
+
+
+        /**
+         * @brief       Constructs an element in allocated storage.
+         */
+        template< typename Other, typename... Args >
+        void construct(Other* p, Args&&... args) {
+            ::new((void*) p) Other(std::forward< Args >(args)...);
+        }
+
+
+        /**
+         * @brief       Destroys an element in allocated storage.
+         */
+        template< typename Other >
+        void destroy(Other* p) {
+            p->~Other();
+        }
+
+    };
+
+
+    // Comparison operators, all allocators of the same alignment are
+    // interchangeable.
+
+    template< typename Type1, typename Type2, size_t Alignment > inline
+    bool operator==(const AlignedAllocator_< Type1, Alignment >&,
+                    const AlignedAllocator_< Type2, Alignment >&) {
+        return true;
+    }
+
+    template< typename Type1, typename Type2, size_t Alignment > inline
+    bool operator!=(const AlignedAllocator_< Type1, Alignment >&,
+                    const AlignedAllocator_< Type2, Alignment >&) {
+        return false;
+    }
+
+
+} // namespace cvx
+
+
+#endif // CVX_UTIL_ALIGNED_ALLOCATOR_HPP__INCLUDED
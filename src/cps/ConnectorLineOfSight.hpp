@@ -0,0 +1,240 @@
+/**
+ * @file        ConnectorLineOfSight.hpp
+ *
+ * @brief       A line-of-sight connection survey functor class. Two points
+ *              are connected if the straight segment joining them lies
+ *              within a planar set (the inside of a shape).
+ *
+ * This file is part of The Computer Vision Tools Project. It is subject to the
+ * license terms in the [LICENSE.md](../license/LICENSE.md) file found in the
+ * `licenses` sub-folder of the top-level directory of this distribution and at
+ * https://bitbucket.org/cpslccauna/CPSignature/license/LICENSE.md. No part of
+ * this project, including this file, may be copied, modified, propagated, or
+ * distributed except according to the terms contained in the above LICENSE
+ * file.
+ *
+ * See the [COPYING.md](../COPYING.md) file at the top-level directory of this
+ * distribution and at https://bitbucket.org/cpslccauna/CPSignature/COPYING.md
+ * for more legal information.
+ */
+
+#ifndef CVX_METRIC_CONNECTOR_LINE_OF_SIGHT_HPP__INCLUDED
+#define CVX_METRIC_CONNECTOR_LINE_OF_SIGHT_HPP__INCLUDED
+
+#pragma once
+
+#include "Imports.hpp"
+#include "PlanarSet.hpp"
+#include <cmath>
+
+
+namespace cvx {
+
+    /**
+     * @class       ConnectorLineOfSight
+     *
+     * @brief       Class for line-of-sight connection survey functors.
+     *
+     * @details     Two points are connected if every pixel of the digital
+     *              straight segment joining them belongs to the planar set
+     *              given by the user, so connective distances built upon
+     *              this functor measure inner visibility within a shape.
+     *
+     * @version     1.0
+     */
+    class ConnectorLineOfSight {
+
+    public:
+
+        /**
+         * @brief      A type for a 2D connectivity maps.
+         */
+        typedef PlanarSet map_t;
+
+
+    public:
+
+        /**
+         * @brief      Default constructor.
+         */
+        ConnectorLineOfSight() {
+            // NOOP
+        }
+
+
+        /**
+         * @brief       Copy constructor.
+         *
+         * @param[in]   src  A connection survey functor.
+         */
+        ConnectorLineOfSight(const ConnectorLineOfSight& src) :
+        _map(src._map) {
+            // NOOP
+        }
+
+
+        /**
+         * @brief       Move constructor.
+         *
+         * @param[in]   src  A connection survey functor.
+         */
+        ConnectorLineOfSight(ConnectorLineOfSight&& src) :
+        _map(std::move(src._map)) {
+            // NOOP
+        }
+
+
+        /**
+         * @brief       Normal constructor.
+         *
+         * @param[in]   map  A connectivity map mask.
+         */
+        ConnectorLineOfSight(const PlanarSet& map) :
+        _map(map) {
+            // NOOP
+        }
+
+
+        /**
+         * @brief       Normal constructor.
+         *
+         * @param[in]   map  A connectivity map mask.
+         */
+        ConnectorLineOfSight(PlanarSet&& map) :
+        _map(std::move(map)) {
+            // NOOP
+        }
+
+
+        /**
+         * @brief      Destructor.
+         */
+        ~ConnectorLineOfSight() {
+            // NOOP
+        }
+
+
+        /**
+         * @brief       Copy assignment operator.
+         *
+         * @param[in]   src  A connection survey functor.
+         */
+        ConnectorLineOfSight& operator=(const ConnectorLineOfSight& src) {
+            return assign(src);
+        }
+
+
+        /**
+         * @brief       Move assignment operator.
+         *
+         * @param[in]   src  A connection survey functor.
+         */
+        ConnectorLineOfSight& operator=(ConnectorLineOfSight&& src) {
+            return assign(std::move(src));
+        }
+
+
+        /**
+         * @brief       Copy assignment.
+         *
+         * @param[in]   src  A connection survey functor.
+         */
+        ConnectorLineOfSight& assign(const ConnectorLineOfSight& src) {
+            _map = src._map;
+            return *this;
+        }
+
+
+        /**
+         * @brief       Move assignment.
+         *
+         * @param[in]   src  A connection survey functor.
+         */
+        ConnectorLineOfSight& assign(ConnectorLineOfSight&& src) {
+            _map = std::move(src._map);
+            return *this;
+        }
+
+
+        /**
+         * @brief       Copy setter.
+         *
+         * @param[in]   map  A connectivity map mask.
+         */
+        void set(const PlanarSet& map) {
+            _map = map;
+        }
+
+
+        /**
+         * @brief       Move setter.
+         * @param[in]   map  A connectivity map mask.
+         */
+        void set(PlanarSet&& map) {
+            _map = std::move(map);
+        }
+
+
+        /**
+         * @brief   Returns the connectivity map mask.
+         */
+        const PlanarSet& map() const {
+            return _map;
+        }
+
+
+        /**
+         * @brief   Check if directed or asymmetric connection is supported.
+         *
+         * @return  False, the segment from `P` to `Q` is the segment from
+         *          `Q` to `P`.
+         */
+        static bool directed() {
+            return false;
+        }
+
+
+        /**
+         * @brief       Verify if two 2D points are connected by a straight
+         *              line residing within point set defined in the user
+         *              provided map.
+         *
+         * @remark      Points are rounded to the nearest pixel.
+         *
+         * @param[in]   p1  A constant reference to the first point.
+         *
+         * @param[in]   p2  A constant reference to the second point.
+         *
+         * @return      True if `p1` and `p2` are connected by a path, false
+         *              otherwise.
+         */
+        template< typename Type >
+        bool operator()(const Point_< Type >& p1,
+                        const Point_< Type >& p2) const {
+            return _map.visible(pixel(p1), pixel(p2));
+        }
+
+
+    private:
+
+        /**
+         * @brief       Returns the pixel containing a 2D point.
+         */
+        template< typename Type >
+        static Point pixel(const Point_< Type >& p) {
+            return Point(static_cast< int > (std::floor(p.x + (Real) 0.5)),
+                         static_cast< int > (std::floor(p.y + (Real) 0.5)));
+        }
+
+
+    private:
+
+        PlanarSet _map; /**< Connectivity map mask. */
+
+    };
+
+
+} // namespace cvx
+
+
+#endif // CVX_METRIC_CONNECTOR_LINE_OF_SIGHT_HPP__INCLUDED
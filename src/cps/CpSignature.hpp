@@ -28,6 +28,8 @@
 #pragma once
 
 #include "CpsMatrix.hpp"
+#include "CpsSamplingPlan.hpp"
+#include "CurveArcLength.hpp"
 #include "DistanceL2.hpp"
 #include <cassert>
 
@@ -57,7 +59,9 @@ namespace cvx {
                     dm = k / M, dn = k / (N + 1);
             const Real inorm = (Real) 1 / norm;
             const distance_t dis;
-            Matrix1r mtx(M, N);
+            Matrix1r mtx = CpsMatrix::allocate(M, N);
+            // Points of a row, as a structure of arrays for `batch()`.
+            std::vector< Real > xs(N), ys(N);
             for (unsigned i = 0, m = 0; i < M; ++i, m += dm) {
                 // m = 0, dm, 2dm, ...
                 Real* p = mtx.ptr<Real>(i);
@@ -66,12 +70,80 @@ namespace cvx {
                     if (n >= k) {
                         n %= k;
                     }
-                    p[j] = dis(ctr[m], ctr[n]) * inorm;
+                    xs[j] = (Real) ctr[n].x;
+                    ys[j] = (Real) ctr[n].y;
+                }
+                dis.batch(ctr[m], xs.data(), ys.data(), p, N);
+                for (unsigned j = 0; j < N; ++j) {
+                    p[j] *= inorm;
                 }
             }
             return CpsMatrix(std::move(mtx));
         }
 
+        /**
+         * @brief       Computes a signature matrix interpolating, on demand,
+         *              only the contour points it reads.
+         *
+         * @details     Unlike `full_cps()`, the contour is not required to
+         *              have `sampling(M, N)` points. The positions read by
+         *              `full_cps()` are computed by a `CpsSamplingPlan` and
+         *              interpolated from an arc-length parameterized curve,
+         *              so neither memory nor time depend on `lcm(M, N + 1)`.
+         *
+         * @param[in]   crv  An arc-length parameterized curve, e.g., a
+         *              `CurveArcLength` object, or a spline implementing
+         *              members `length()` and `at(s, hint)`.
+         * @param[in]   M Curve sampling size.
+         * @param[in]   N Signature sampling size.
+         * @param[in]   norm Normalization factor.
+         * @return      The `M x N` signature matrix.
+         */
+        template< typename Curve >
+        CpsMatrix lazy_cps(const Curve& crv, const unsigned M,
+                           const unsigned N, const Real norm) {
+            CV_Assert(M >= 3 and N >= 3);
+            const CpsSamplingPlan plan(M, N);
+            const Real step = crv.length() / (Real) plan.size();
+            const Real inorm = (Real) 1 / norm;
+            const distance_t dis;
+            Matrix1r mtx = CpsMatrix::allocate(M, N);
+            // Points of a row, as a structure of arrays for `batch()`.
+            std::vector< Real > xs(N), ys(N);
+            unsigned ha = 0;
+            for (unsigned i = 0; i < M; ++i) {
+                const Point2r a = crv.at(plan.anchor(i) * step, ha);
+                Real* p = mtx.ptr<Real>(i);
+                // Positions increase along the row, wrapping around once.
+                unsigned hn = ha;
+                for (unsigned j = 0; j < N; ++j) {
+                    const Point2r b = crv.at(plan.position(i, j) * step, hn);
+                    xs[j] = b.x;
+                    ys[j] = b.y;
+                }
+                dis.batch(a, xs.data(), ys.data(), p, N);
+                for (unsigned j = 0; j < N; ++j) {
+                    p[j] *= inorm;
+                }
+            }
+            return CpsMatrix(std::move(mtx));
+        }
+
+        /**
+         * @brief       Computes a signature matrix interpolating, on demand,
+         *              only the contour points it reads.
+         *
+         * @param[in]   ctr The vertices of a closed contour, of any size.
+         * @param[in]   M Curve sampling size.
+         * @param[in]   N Signature sampling size.
+         * @param[in]   norm Normalization factor.
+         * @return      The `M x N` signature matrix.
+         */
+        CpsMatrix lazy_cps(const std::vector<cv::Point>& ctr, const unsigned M,
+                           const unsigned N, const Real norm) {
+            return lazy_cps(CurveArcLength(ctr), M, N, norm);
+        }
+
         /**
          * @brief       Returns a suitable contour sampling size for the
          *              required signature.
@@ -32,6 +32,19 @@ namespace cvx {
         return (_cps = src._cps, *this);
     }
 
+    CpsMatrix::matrix_t CpsMatrix::allocate(const unsigned rows, const unsigned cols) {
+        const unsigned align = CVX_ALIGNMENT / sizeof(Real);
+        const unsigned stride = (cols + align - 1) / align * align;
+        // Padded rows, plus one alignment unit to shift the data to an
+        // aligned address.
+        matrix_t buffer(rows, stride + align);
+        const size_t misalign = reinterpret_cast< uintptr_t > (buffer.data) % CVX_ALIGNMENT;
+        const unsigned offset = (misalign == 0) ? 0 : (unsigned) ((CVX_ALIGNMENT - misalign) / sizeof(Real));
+        return buffer.colRange(offset, offset + cols);
+    }
+
+    const char CpsSignatureNode[] = "CpsSignature";
+
 
 
 } // namespace cvx
@@ -30,9 +30,20 @@
 
 #include "Imports.hpp"
 #include "Persistence.hpp"
+#include "Signature.hpp"
 
 namespace cvx {
 
+    /**
+     * @brief   Persistence node name of the per-point signatures.
+     */
+    extern const char CpsSignatureNode[];
+
+    /**
+     * @brief   Per-point signature, a row of a signature matrix.
+     */
+    typedef Signature_< CpsSignatureNode > CpsSignature;
+
     class CpsMatrix {
     public:
         
@@ -95,6 +106,24 @@ namespace cvx {
             return _cps;
         }
 
+        /**
+         * @brief   Returns the signature of a sampled point, a zero-copy
+         *          view of row `i` of the signature matrix; it is valid as
+         *          long as this matrix is.
+         */
+        CpsSignature signature(const unsigned i) const {
+            return CpsSignature::view(_cps.ptr<Real>(i), _cps.cols);
+        }
+
+        /**
+         * @brief   Allocates a signature matrix whose rows start at
+         *          `CVX_ALIGNMENT` bytes boundaries, padding them as
+         *          needed, so row signatures are aligned for SIMD loads.
+         * @param   rows Sampling size.
+         * @param   cols Definition.
+         */
+        static matrix_t allocate(const unsigned rows, const unsigned cols);
+
     private:
 
         Matrix1r _cps;
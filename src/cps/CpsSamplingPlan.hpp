@@ -0,0 +1,165 @@
+/**
+ * @file        CpsSamplingPlan.hpp
+ *
+ * @brief       Defines the contour sampling plan of a Contour-Point
+ *              signature matrix.
+ *
+ * This file is part of The Computer Vision Tools Project. It is subject to the
+ * license terms in the [LICENSE.md](../license/LICENSE.md) file found in the
+ * `licenses` sub-folder of the top-level directory of this distribution and at
+ * https://bitbucket.org/cpslccauna/CPSignature/license/LICENSE.md. No part of
+ * this project, including this file, may be copied, modified, propagated, or
+ * distributed except according to the terms contained in the above LICENSE
+ * file.
+ *
+ * See the [COPYING.md](../COPYING.md) file at the top-level directory of this
+ * distribution and at https://bitbucket.org/cpslccauna/CPSignature/COPYING.md
+ * for more legal information.
+ */
+
+#ifndef CVX_DESCRIPTOR_CPS_SAMPLING_PLAN_HPP__INCLUDED
+#define CVX_DESCRIPTOR_CPS_SAMPLING_PLAN_HPP__INCLUDED
+
+#pragma once
+
+#include "Imports.hpp"
+#include <cmath>
+
+
+namespace cvx {
+
+    /**
+     * @class       CpsSamplingPlan
+     *
+     * @brief       Contour positions read by a `M x N` signature matrix.
+     *
+     * @details     A `M x N` signature samples `M` anchor points from the
+     *              contour, and for each anchor `N` points evenly spaced
+     *              along the contour. Both grids are aligned on a common
+     *              grid of `k = lcm(M, N + 1)` positions; the anchor `i` is
+     *              at position `i dm`, and its `j`-th point is at position
+     *              `i dm + (j + 1) dn (mod k)`, where `dm = k / M` and
+     *              `dn = k / (N + 1)`.
+     *
+     * @remark      The plan does not hold any position, it only computes
+     *              them, so the cost of using it does not depend on `k`.
+     *              Positions are given on the `k`-grid (as `full_cps`
+     *              reads them), and as fractions of the contour length
+     *              (as lazy builders interpolate them).
+     *
+     * @version     1.0
+     */
+    class CpsSamplingPlan {
+
+    public:
+
+        /**
+         * @brief       Normal constructor.
+         *
+         * @param[in]   m  Curve sampling size.
+         *
+         * @param[in]   n  Signature sampling size.
+         */
+        CpsSamplingPlan(const unsigned m, const unsigned n) :
+        _m(m), _n(n), _k(lcm(m, n + 1)), _dm(_k / m), _dn(_k / (n + 1)) {
+            // NOOP
+        }
+
+
+        /**
+         * @brief      Destructor.
+         */
+        ~CpsSamplingPlan() {
+            // NOOP
+        }
+
+
+        /**
+         * @brief   Returns the number of anchor points (signature matrix
+         *          rows).
+         */
+        unsigned rows() const {
+            return _m;
+        }
+
+
+        /**
+         * @brief   Returns the number of points per signature (signature
+         *          matrix columns).
+         */
+        unsigned cols() const {
+            return _n;
+        }
+
+
+        /**
+         * @brief   Returns the size `k` of the common sampling grid.
+         */
+        unsigned size() const {
+            return _k;
+        }
+
+
+        /**
+         * @brief       Returns the grid position of an anchor point.
+         *
+         * @param[in]   i  Row index, within `[0, rows())`.
+         */
+        unsigned anchor(const unsigned i) const {
+            return i * _dm;
+        }
+
+
+        /**
+         * @brief       Returns the grid position of a signature point.
+         *
+         * @param[in]   i  Row index, within `[0, rows())`.
+         *
+         * @param[in]   j  Column index, within `[0, cols())`.
+         */
+        unsigned position(const unsigned i, const unsigned j) const {
+            const unsigned p = i * _dm + (j + 1) * _dn;
+            return (p >= _k) ? p - _k : p;
+        }
+
+
+        /**
+         * @brief       Returns a grid position as a fraction, within
+         *              `[0, 1)`, of the contour length.
+         *
+         * @param[in]   p  A grid position, within `[0, size())`.
+         */
+        Real fraction(const unsigned p) const {
+            return (Real) p / (Real) _k;
+        }
+
+
+        /**
+         * @brief       Returns the least common multiple of two integers.
+         */
+        static unsigned lcm(const unsigned a, const unsigned b) {
+            unsigned u = a, v = b;
+            while (v != 0) {
+                const unsigned t = u % v;
+                u = v;
+                v = t;
+            }
+            // u : Greatest common divisor of a and b.
+            return (a / u) * b;
+        }
+
+    private:
+
+        unsigned _m, _n; /**< Signature matrix size. */
+
+        unsigned _k; /**< Size of the common sampling grid. */
+
+        unsigned _dm, _dn; /**< Grid steps between anchors and points. */
+
+    };
+
+
+} // namespace cvx
+
+
+#endif // CVX_DESCRIPTOR_CPS_SAMPLING_PLAN_HPP__INCLUDED
@@ -0,0 +1,178 @@
+/**
+ * @file        CurveArcLength.hpp
+ *
+ * @brief       Defines an arc-length parameterization of a closed polygonal
+ *              curve (contour).
+ *
+ * This file is part of The Computer Vision Tools Project. It is subject to the
+ * license terms in the [LICENSE.md](../license/LICENSE.md) file found in the
+ * `licenses` sub-folder of the top-level directory of this distribution and at
+ * https://bitbucket.org/cpslccauna/CPSignature/license/LICENSE.md. No part of
+ * this project, including this file, may be copied, modified, propagated, or
+ * distributed except according to the terms contained in the above LICENSE
+ * file.
+ *
+ * See the [COPYING.md](../COPYING.md) file at the top-level directory of this
+ * distribution and at https://bitbucket.org/cpslccauna/CPSignature/COPYING.md
+ * for more legal information.
+ */
+
+#ifndef CVX_GEOMETRY_CURVE_ARC_LENGTH_HPP__INCLUDED
+#define CVX_GEOMETRY_CURVE_ARC_LENGTH_HPP__INCLUDED
+
+#pragma once
+
+#include "Imports.hpp"
+#include "Math.hpp"
+#include <algorithm>
+
+
+namespace cvx {
+
+    /**
+     * @class       CurveArcLength
+     *
+     * @brief       Arc-length parameterization of a closed polygonal curve.
+     *
+     * @details     Objects of this class hold the vertices of a closed
+     *              contour and its cumulative chord lengths, so points at
+     *              arbitrary arc-length positions can be interpolated on
+     *              demand, without resampling the whole contour.
+     *
+     * @remark      This class defines the interface for curve
+     *              parameterizations used by the lazy signature builders,
+     *              i.e., `length()` and `at()`. A spline, or any other
+     *              parameterized curve, can be used in its place as long
+     *              as it implements both members.
+     *
+     * @version     1.0
+     */
+    class CurveArcLength {
+
+    public:
+
+        /**
+         * @brief      Default constructor.
+         */
+        CurveArcLength() :
+        _length(0) {
+            // NOOP
+        }
+
+
+        /**
+         * @brief       Normal constructor.
+         *
+         * @param[in]   ctr  The vertices of a closed contour.
+         */
+        template< typename Type >
+        explicit CurveArcLength(const std::vector< Point_< Type > >& ctr) :
+        _length(0) {
+            set(ctr);
+        }
+
+
+        /**
+         * @brief      Destructor.
+         */
+        ~CurveArcLength() {
+            // NOOP
+        }
+
+
+        /**
+         * @brief       Setter.
+         *
+         * @param[in]   ctr  The vertices of a closed contour.
+         */
+        template< typename Type >
+        void set(const std::vector< Point_< Type > >& ctr) {
+            CV_Assert(ctr.size() >= 2);
+            const unsigned n = static_cast< unsigned > (ctr.size());
+            _vtx.resize(n + 1);
+            _acc.resize(n + 1);
+            for (unsigned i = 0; i < n; ++i) {
+                _vtx[i] = Point2r((Real) ctr[i].x, (Real) ctr[i].y);
+            }
+            // Close the curve, the last chord returns to the first vertex.
+            _vtx[n] = _vtx[0];
+            _acc[0] = 0;
+            for (unsigned i = 1; i <= n; ++i) {
+                _acc[i] = _acc[i - 1] + dist_l2(_vtx[i - 1], _vtx[i]);
+            }
+            _length = _acc[n];
+        }
+
+
+        /**
+         * @brief   Returns the number of vertices of the curve.
+         */
+        unsigned size() const {
+            return _vtx.empty() ? 0 : static_cast< unsigned > (_vtx.size() - 1);
+        }
+
+
+        /**
+         * @brief   Returns the total length (perimeter) of the curve.
+         */
+        Real length() const {
+            return _length;
+        }
+
+
+        /**
+         * @brief       Interpolates the point at a given arc-length position.
+         *
+         * @param[in]   s  Arc-length position, within `[0, length())`.
+         *
+         * @param[in,out] hint  Index of the chord where the search starts.
+         *              It is updated to the chord containing `s`, so that
+         *              monotone queries run in amortized constant time.
+         *
+         * @return      The interpolated point.
+         */
+        Point2r at(Real s, unsigned& hint) const {
+            const unsigned n = size();
+            if (hint >= n or _acc[hint] > s) {
+                // Wrapped around, or moved backwards: binary search.
+                const std::vector< Real >::const_iterator it =
+                        std::upper_bound(_acc.begin(), _acc.end(), s);
+                hint = static_cast< unsigned > (it - _acc.begin());
+                hint = (hint == 0) ? 0 : std::min(hint - 1, n - 1);
+            }
+            while (hint + 1 < n and _acc[hint + 1] <= s) {
+                ++hint;
+            }
+            const Real len = _acc[hint + 1] - _acc[hint];
+            const Real t = (len > 0) ? (s - _acc[hint]) / len : (Real) 0;
+            return _vtx[hint] + (_vtx[hint + 1] - _vtx[hint]) * t;
+        }
+
+
+        /**
+         * @brief       Interpolates the point at a given arc-length position.
+         *
+         * @param[in]   s  Arc-length position, within `[0, length())`.
+         *
+         * @return      The interpolated point.
+         */
+        Point2r at(Real s) const {
+            unsigned hint = size();
+            return at(s, hint);
+        }
+
+    private:
+
+        std::vector< Point2r > _vtx; /**< Vertices, first one repeated. */
+
+        std::vector< Real > _acc; /**< Cumulative chord lengths. */
+
+        Real _length; /**< Total length of the curve. */
+
+    };
+
+
+} // namespace cvx
+
+
+#endif // CVX_GEOMETRY_CURVE_ARC_LENGTH_HPP__INCLUDED
@@ -0,0 +1,313 @@
+/**
+ * @file        Descriptor.hpp
+ *
+ * @brief       Defines a (discrete) descriptor metaclass, with aligned
+ *              contiguous storage, owned or viewed.
+ *
+ * This file is part of The Computer Vision Tools Project. It is subject to the
+ * license terms in the [LICENSE.md](../license/LICENSE.md) file found in the
+ * `licenses` sub-folder of the top-level directory of this distribution and at
+ * https://bitbucket.org/cpslccauna/CPSignature/license/LICENSE.md. No part of
+ * this project, including this file, may be copied, modified, propagated, or
+ * distributed except according to the terms contained in the above LICENSE
+ * file.
+ *
+ * See the [COPYING.md](../COPYING.md) file at the top-level directory of this
+ * distribution and at https://bitbucket.org/cpslccauna/CPSignature/COPYING.md
+ * for more legal information.
+ */
+
+#ifndef CVX_DESCRIPTOR_DESCRIPTOR_HPP__INCLUDED
+#define CVX_DESCRIPTOR_DESCRIPTOR_HPP__INCLUDED
+
+#pragma once
+
+#include "Imports.hpp"
+#include "AlignedAllocator.hpp"
+#include <cstdint>
+#include <utility>
+
+
+namespace cvx {
+
+    /**
+     * @tclass      Descriptor_< * >
+     *
+     * @brief       Class template for (discrete) descriptors, i.e., fixed
+     *              length feature vectors.
+     *
+     * @details     A descriptor either owns its features, in contiguous
+     *              storage aligned to `CVX_ALIGNMENT` bytes, or is a view
+     *              of features owned by someone else, e.g., a row of a
+     *              signature matrix; both are read the same way.
+     *
+     * @remark      Owning descriptors are move-only, so features are never
+     *              copied implicitly: use `clone()` for a deep copy, and
+     *              `view()` for a non-owning reference. A view must not
+     *              outlive the storage it refers to.
+     *
+     * @tparam      FeatureType  The feature (element) type.
+     *
+     * @tparam      NODENAME  Name of the persistence node of descriptors of
+     *              this class.
+     *
+     * @version     1.0
+     */
+    template< typename FeatureType, const char* const NODENAME >
+    class Descriptor_ {
+
+    public:
+
+        /**
+         * @brief      A type for features.
+         */
+        typedef FeatureType value_type;
+
+        /**
+         * @brief      A type for aligned owned storage.
+         */
+        typedef std::vector< FeatureType, AlignedAllocator_< FeatureType > > vector_t;
+
+
+    public:
+
+        /**
+         * @brief      Default constructor.
+         */
+        Descriptor_() :
+        _ptr(0), _size(0) {
+            // NOOP
+        }
+
+
+        /**
+         * @brief       Copy constructor, deleted: descriptors are move-only.
+         */
+        Descriptor_(const Descriptor_& src) = delete;
+
+
+        /**
+         * @brief           Move constructor.
+         * @param[in,out]   tmp A rvalue reference to a source object.
+         */
+        Descriptor_(Descriptor_&& tmp) :
+        _data(std::move(tmp._data)), _ptr(tmp._ptr), _size(tmp._size) {
+            tmp._ptr = 0;
+            tmp._size = 0;
+        }
+
+
+        /**
+         * @brief       Clone constructor, converts the features.
+         * @param[in]   src A constant reference to a compatible source object.
+         */
+        template< typename OtherFeatureType >
+        explicit Descriptor_(const Descriptor_< OtherFeatureType, NODENAME >& src) :
+        _data(src.begin(), src.end()), _ptr(_data.data()), _size(_data.size()) {
+            // NOOP
+        }
+
+
+        /**
+         * @brief       Copy wrapper constructor.
+         * @param[in]   data A constant reference to a data vector.
+         */
+        explicit Descriptor_(const vector_t& data) :
+        _data(data), _ptr(_data.data()), _size(_data.size()) {
+            // NOOP
+        }
+
+
+        /**
+         * @brief           Move wrapper constructor.
+         * @param[in,out]   data A rvalue reference to a data vector.
+         */
+        explicit Descriptor_(vector_t&& data) :
+        _data(std::move(data)), _ptr(_data.data()), _size(_data.size()) {
+            // NOOP
+        }
+
+
+        /**
+         * @brief      Destructor.
+         */
+        ~Descriptor_() {
+            // NOOP
+        }
+
+
+        /**
+         * @brief       Copy assignment operator, deleted: descriptors are
+         *              move-only.
+         */
+        Descriptor_& operator=(const Descriptor_& src) = delete;
+
+
+        /**
+         * @brief           Move assignment operator.
+         * @param[in,out]   tmp A rvalue reference to a source object.
+         */
+        Descriptor_& operator=(Descriptor_&& tmp) {
+            return assign(std::move(tmp));
+        }
+
+
+        /**
+         * @brief           Move assignment.
+         * @param[in,out]   tmp A rvalue reference to a source object.
+         */
+        Descriptor_& assign(Descriptor_&& tmp) {
+            if (this != &tmp) {
+                _data = std::move(tmp._data);
+                _ptr = tmp._ptr;
+                _size = tmp._size;
+                tmp._ptr = 0;
+                tmp._size = 0;
+            }
+            return *this;
+        }
+
+
+        /**
+         * @brief       Creates a non-owning view of contiguous features.
+         *
+         * @param[in]   data  Pointer to the first feature.
+         *
+         * @param[in]   size  Number of features.
+         */
+        static Descriptor_ view(const FeatureType* data, const size_t size) {
+            Descriptor_ d;
+            d._ptr = data;
+            d._size = size;
+            return d;
+        }
+
+
+        /**
+         * @brief   Returns a non-owning view of this descriptor.
+         */
+        Descriptor_ view() const {
+            return view(_ptr, _size);
+        }
+
+
+        /**
+         * @brief   Returns an owning deep copy of this descriptor.
+         */
+        Descriptor_ clone() const {
+            return Descriptor_(vector_t(begin(), end()));
+        }
+
+
+        /**
+         * @brief   Check if this descriptor owns its features.
+         */
+        bool owner() const {
+            return _ptr != 0 and _ptr == _data.data();
+        }
+
+
+        /**
+         * @brief   Check if the features start at a `CVX_ALIGNMENT` bytes
+         *          boundary (owned features always do).
+         */
+        bool aligned() const {
+            return reinterpret_cast< uintptr_t > (_ptr) % CVX_ALIGNMENT == 0;
+        }
+
+
+        /**
+         * @brief   Returns the number of features.
+         */
+        size_t size() const {
+            return _size;
+        }
+
+
+        /**
+         * @brief   Check if this descriptor has no features.
+         */
+        bool empty() const {
+            return _size == 0;
+        }
+
+
+        /**
+         * @brief   Returns a pointer to the contiguous features.
+         */
+        const FeatureType* data() const {
+            return _ptr;
+        }
+
+
+        /**
+         * @brief   Feature accessor.
+         */
+        const FeatureType& operator[](const size_t i) const {
+            return _ptr[i];
+        }
+
+
+        /**
+         * @brief   Returns a pointer to the first feature.
+         */
+        const FeatureType* begin() const {
+            return _ptr;
+        }
+
+
+        /**
+         * @brief   Returns a pointer past the last feature.
+         */
+        const FeatureType* end() const {
+            return _ptr + _size;
+        }
+
+
+        /**
+         * @brief   Returns the name of the persistence node.
+         */
+        static const char* nodeName() {
+            return NODENAME;
+        }
+
+
+        /**
+         * @brief       Writes the features, as a row matrix, to a storage.
+         */
+        void writeTo(FileStorage& fs) const {
+            fs << NODENAME << Mat_< FeatureType >(1, static_cast< int > (_size),
+                                                   const_cast< FeatureType* > (_ptr));
+        }
+
+
+        /**
+         * @brief       Reads the features from a storage, into owned
+         *              storage.
+         */
+        void readFrom(FileStorage& fs) {
+            Mat_< FeatureType > m;
+            fs[NODENAME] >> m;
+            vector_t data;
+            for (int i = 0; i < m.rows; ++i) {
+                data.insert(data.end(), m[i], m[i] + m.cols);
+            }
+            *this = Descriptor_(std::move(data));
+        }
+
+
+    private:
+
+        vector_t _data; /**< Owned features, empty for views. */
+
+        const FeatureType* _ptr; /**< First feature. */
+
+        size_t _size; /**< Number of features. */
+
+    };
+
+
+} // namespace cvx
+
+
+#endif // CVX_DESCRIPTOR_DESCRIPTOR_HPP__INCLUDED
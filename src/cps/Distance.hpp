@@ -65,9 +65,11 @@ namespace cvx {
      *              distance functors, and copy and move setters, `set()`
      *              members, for norm functors. Also **must** overload the
      *              function call `operator()` for computing the distance
-     *              between pairs of 2D points. The same for member function
-     *              `embedded()`, which is added to be compatible with
-     *              connectiveness checking distance functors.
+     *              between pairs of 2D points, and the `batch()` members
+     *              for computing it over structure-of-arrays point sets.
+     *              The same for member function `embedded()`, which is
+     *              added to be compatible with connectiveness checking
+     *              distance functors.
      *
      * @remark      Special cases requiring additional information can have
      *              additional constructors, methods and data members as
@@ -361,6 +363,63 @@ namespace cvx {
             return embedded(p1, p2);
         }
 
+
+        /**
+         * @brief       Compute the distances from a 2D point to each point
+         *              of a structure-of-arrays (SoA) point set.
+         *
+         * @remark      This is a mandatory member function.
+         *
+         * @param[in]   p  A constant reference to the first point.
+         *
+         * @param[in]   xs  Contiguous array of abscissae.
+         *
+         * @param[in]   ys  Contiguous array of ordinates.
+         *
+         * @param[out]  out  Contiguous array receiving the `count`
+         *              distances.
+         *
+         * @param[in]   count  Number of points in `xs` and `ys`.
+         */
+        template< typename Type >
+        void batch(const Point_< Type >& p, const Real* xs, const Real* ys,
+                   Real* out, const unsigned count) const {
+            norm.batch((Real) p.x, (Real) p.y, xs, ys, out, count);
+        }
+
+
+        /**
+         * @brief       Compute the distances between each point of a SoA
+         *              point set and each point of another one.
+         *
+         * @remark      This is a mandatory member function.
+         *
+         * @param[in]   xa  Contiguous array of abscissae of the first set.
+         *
+         * @param[in]   ya  Contiguous array of ordinates of the first set.
+         *
+         * @param[in]   na  Number of points in the first set.
+         *
+         * @param[in]   xb  Contiguous array of abscissae of the second set.
+         *
+         * @param[in]   yb  Contiguous array of ordinates of the second set.
+         *
+         * @param[in]   nb  Number of points in the second set.
+         *
+         * @param[out]  out  Output matrix, the distance between points `i`
+         *              and `j` is written to `out[i * stride + j]`.
+         *
+         * @param[in]   stride  Distance, in elements, between the rows of
+         *              `out`.
+         */
+        void batch(const Real* xa, const Real* ya, const unsigned na,
+                   const Real* xb, const Real* yb, const unsigned nb,
+                   Real* out, const size_t stride) const {
+            for (unsigned i = 0; i < na; ++i) {
+                batch(Point_< Real >(xa[i], ya[i]), xb, yb, out + i * stride, nb);
+            }
+        }
+
     public:
 
         norm_t norm; /**< A embedded norm functor. */
@@ -79,6 +79,119 @@ namespace cvx {
 
     public:
 
+        /**
+         * @brief      Default constructor.
+         */
+        DistanceConnective_() {
+            // NOOP
+        }
+
+
+        /**
+         * @brief       Copy constructor.
+         *
+         * @param[in]   src  A connective distance functor.
+         */
+        DistanceConnective_(const DistanceConnective_& src) :
+        norm(src.norm),
+        connector(src.connector) {
+            // NOOP
+        }
+
+
+        /**
+         * @brief       Move constructor.
+         *
+         * @param[in]   src  A connective distance functor.
+         */
+        DistanceConnective_(DistanceConnective_&& src) :
+        norm(std::move(src.norm)),
+        connector(std::move(src.connector)) {
+            // NOOP
+        }
+
+
+        /**
+         * @brief       Normal constructor.
+         *
+         * @param[in]   nrm  A norm functor.
+         */
+        DistanceConnective_(const norm_t& nrm) :
+        norm(nrm) {
+            // NOOP
+        }
+
+
+        /**
+         * @brief       Normal constructor.
+         *
+         * @param[in]   nrm  A norm functor.
+         */
+        DistanceConnective_(norm_t&& nrm) :
+        norm(std::move(nrm)) {
+            // NOOP
+        }
+
+
+        /**
+         * @brief       Normal constructor.
+         *
+         * @param[in]   con  A connection survey functor.
+         */
+        DistanceConnective_(const connector_t& con) :
+        connector(con) {
+            // NOOP
+        }
+
+
+        /**
+         * @brief       Normal constructor.
+         *
+         * @param[in]   con  A connection survey functor.
+         */
+        DistanceConnective_(connector_t&& con) :
+        connector(std::move(con)) {
+            // NOOP
+        }
+
+
+        /**
+         * @brief       Normal constructor.
+         *
+         * @param[in]   nrm  A norm functor.
+         *
+         * @param[in]   con  A connection survey functor.
+         */
+        DistanceConnective_(const norm_t& nrm,
+                            const connector_t& con) :
+        norm(nrm),
+        connector(con) {
+            // NOOP
+        }
+
+
+        /**
+         * @brief       Normal constructor.
+         *
+         * @param[in]   nrm  A norm functor.
+         *
+         * @param[in]   con  A connection survey functor.
+         */
+        DistanceConnective_(norm_t&& nrm,
+                            connector_t&& con) :
+        norm(std::move(nrm)),
+        connector(std::move(con)) {
+            // NOOP
+        }
+
+
+        /**
+         * @brief      Destructor.
+         */
+        ~DistanceConnective_() {
+            // NOOP
+        }
+
 
         /**
          * @brief       Copy assignment operator.
@@ -234,6 +347,70 @@ namespace cvx {
         }
 
 
+        /**
+         * @brief       Compute the distances from a 2D point to each point
+         *              of a structure-of-arrays (SoA) point set.
+         *
+         * @remark      This is a mandatory member function.
+         *
+         * @param[in]   p  A constant reference to the first point.
+         *
+         * @param[in]   xs  Contiguous array of abscissae.
+         *
+         * @param[in]   ys  Contiguous array of ordinates.
+         *
+         * @param[out]  out  Contiguous array receiving the `count`
+         *              distances.
+         *
+         * @param[in]   count  Number of points in `xs` and `ys`.
+         */
+        template< typename Type >
+        void batch(const Point_< Type >& p, const Real* xs, const Real* ys,
+                   Real* out, const unsigned count) const {
+            norm.batch((Real) p.x, (Real) p.y, xs, ys, out, count);
+            // Points not connected to `p` are at infinite distance.
+            const Point_< Real > q((Real) p.x, (Real) p.y);
+            for (unsigned i = 0; i < count; ++i) {
+                if (not connected(q, Point_< Real >(xs[i], ys[i]))) {
+                    out[i] = CVX_INFTY;
+                }
+            }
+        }
+
+
+        /**
+         * @brief       Compute the distances between each point of a SoA
+         *              point set and each point of another one.
+         *
+         * @remark      This is a mandatory member function.
+         *
+         * @param[in]   xa  Contiguous array of abscissae of the first set.
+         *
+         * @param[in]   ya  Contiguous array of ordinates of the first set.
+         *
+         * @param[in]   na  Number of points in the first set.
+         *
+         * @param[in]   xb  Contiguous array of abscissae of the second set.
+         *
+         * @param[in]   yb  Contiguous array of ordinates of the second set.
+         *
+         * @param[in]   nb  Number of points in the second set.
+         *
+         * @param[out]  out  Output matrix, the distance between points `i`
+         *              and `j` is written to `out[i * stride + j]`.
+         *
+         * @param[in]   stride  Distance, in elements, between the rows of
+         *              `out`.
+         */
+        void batch(const Real* xa, const Real* ya, const unsigned na,
+                   const Real* xb, const Real* yb, const unsigned nb,
+                   Real* out, const size_t stride) const {
+            for (unsigned i = 0; i < na; ++i) {
+                batch(Point_< Real >(xa[i], ya[i]), xb, yb, out + i * stride, nb);
+            }
+        }
+
+
     public:
 
         norm_t norm; /**< A embedded norm functor. */
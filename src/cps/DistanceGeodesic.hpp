@@ -0,0 +1,350 @@
+/**
+ * @file        DistanceGeodesic.hpp
+ *
+ * @brief       Defines a geodesic (inner) distance functor class. The
+ *              distance between two points is the length of the shortest
+ *              path joining them within a planar set (the inside of a
+ *              shape).
+ *
+ * This file is part of The Computer Vision Tools Project. It is subject to the
+ * license terms in the [LICENSE.md](../license/LICENSE.md) file found in the
+ * `licenses` sub-folder of the top-level directory of this distribution and at
+ * https://bitbucket.org/cpslccauna/CPSignature/license/LICENSE.md. No part of
+ * this project, including this file, may be copied, modified, propagated, or
+ * distributed except according to the terms contained in the above LICENSE
+ * file.
+ *
+ * See the [COPYING.md](../COPYING.md) file at the top-level directory of this
+ * distribution and at https://bitbucket.org/cpslccauna/CPSignature/COPYING.md
+ * for more legal information.
+ */
+
+#ifndef CVX_METRIC_DISTANCE_GEODESIC_HPP__INCLUDED
+#define CVX_METRIC_DISTANCE_GEODESIC_HPP__INCLUDED
+
+#pragma once
+
+#include "Imports.hpp"
+#include "Math.hpp"
+#include "PlanarSet.hpp"
+#include "FastMarching.hpp"
+#include <cmath>
+#include <memory>
+
+
+namespace cvx {
+
+    /**
+     * @class       DistanceGeodesic
+     *
+     * @brief       Class for geodesic (inner) distance functors.
+     *
+     * @details     Objects of this class compute the distance between two
+     *              points as the length of the shortest path joining them
+     *              within a planar set, by fast marching from the first
+     *              point. The distance map of the last source is kept, so
+     *              computing the distances from a point to many others,
+     *              e.g., a signature row, costs a single sweep.
+     *
+     * @remark      This functor implements the distance functor interface,
+     *              so it can be used wherever a `Distance_` is. Points are
+     *              rounded to the nearest pixel, and points not connected
+     *              within the set are at distance `CVX_INFTY`.
+     *
+     * @remark      The planar set is shared among copies, but each copy
+     *              has its own distance map buffers; an object is not safe
+     *              to share among threads, copy it for each thread instead.
+     *
+     * @version     1.0
+     */
+    class DistanceGeodesic {
+
+    public:
+
+        /**
+         * @brief      Default constructor (deleted).
+         *
+         * @remark     A geodesic distance can't be computed without a
+         *             planar set, so default construction, as in the
+         *             `CpSignature_` members, is a compile-time error.
+         */
+        DistanceGeodesic() = delete;
+
+
+        /**
+         * @brief       Copy constructor.
+         *
+         * @param[in]   src  A geodesic distance functor.
+         */
+        DistanceGeodesic(const DistanceGeodesic& src) :
+        _map(src._map), _valid(false) {
+            // NOOP
+        }
+
+
+        /**
+         * @brief       Move constructor.
+         *
+         * @param[in]   src  A geodesic distance functor.
+         */
+        DistanceGeodesic(DistanceGeodesic&& src) :
+        _map(std::move(src._map)), _marching(std::move(src._marching)),
+        _valid(src._valid) {
+            // NOOP
+        }
+
+
+        /**
+         * @brief       Normal constructor.
+         *
+         * @param[in]   map  A connectivity map mask.
+         */
+        explicit DistanceGeodesic(const PlanarSet& map) :
+        _map(std::make_shared< PlanarSet >(map)), _valid(false) {
+            // NOOP
+        }
+
+
+        /**
+         * @brief       Normal constructor.
+         *
+         * @param[in]   map  A connectivity map mask.
+         */
+        explicit DistanceGeodesic(PlanarSet&& map) :
+        _map(std::make_shared< PlanarSet >(std::move(map))), _valid(false) {
+            // NOOP
+        }
+
+
+        /**
+         * @brief      Destructor.
+         */
+        ~DistanceGeodesic() {
+            // NOOP
+        }
+
+
+        /**
+         * @brief       Copy assignment operator.
+         *
+         * @param[in]   src  A geodesic distance functor.
+         */
+        DistanceGeodesic& operator=(const DistanceGeodesic& src) {
+            return assign(src);
+        }
+
+
+        /**
+         * @brief       Move assignment operator.
+         *
+         * @param[in]   src  A geodesic distance functor.
+         */
+        DistanceGeodesic& operator=(DistanceGeodesic&& src) {
+            return assign(std::move(src));
+        }
+
+
+        /**
+         * @brief       Copy assignment.
+         *
+         * @param[in]   src  A geodesic distance functor.
+         */
+        DistanceGeodesic& assign(const DistanceGeodesic& src) {
+            _map = src._map;
+            _valid = false;
+            return *this;
+        }
+
+
+        /**
+         * @brief       Move assignment.
+         *
+         * @param[in]   src  A geodesic distance functor.
+         */
+        DistanceGeodesic& assign(DistanceGeodesic&& src) {
+            _map = std::move(src._map);
+            _marching = std::move(src._marching);
+            _valid = src._valid;
+            return *this;
+        }
+
+
+        /**
+         * @brief   Returns the connectivity map mask.
+         */
+        const PlanarSet& map() const {
+            return *_map;
+        }
+
+
+        /**
+         * @brief   Check if this is a conective measure.
+         *
+         * @return  True since this is a connective distance function.
+         */
+        static bool connective() {
+            return true;
+        }
+
+
+        /**
+         * @brief   Check if this is a directed or asymmetric measure.
+         *
+         * @return  False, shortest paths are reversible.
+         */
+        static bool directed() {
+            return false;
+        }
+
+
+        /**
+         * @brief      Check if two 2D points are connected by a path.
+         *
+         * @param[in]  p1  A constant reference to the first point.
+         *
+         * @param[in]  p2  A constant reference to the second point.
+         *
+         * @return     True if point `p1` is connected to point `p2`
+         *             by a path contained within the given map.
+         */
+        template< typename Type >
+        bool connected(const Point_< Type >& p1,
+                       const Point_< Type >& p2) const {
+            return field(pixel(p1)).at(pixel(p2)) < CVX_INFTY;
+        }
+
+
+        /**
+         * @brief       Compute the geodesic distance between two 2D points.
+         *
+         * @param[in]   p1  A constant reference to the first point.
+         *
+         * @param[in]   p2  A constant reference to the second point.
+         *
+         * @return      The distance between points `p1` and `p2`, a
+         *              floating point value of type `Real`.
+         */
+        template< typename Type >
+        Real embedded(const Point_< Type >& p1,
+                      const Point_< Type >& p2) const {
+            return field(pixel(p1)).at(pixel(p2));
+        }
+
+
+        /**
+         * @brief       Compute the geodesic distance between two 2D points.
+         *
+         * @param[in]   p1  A constant reference to the first point.
+         *
+         * @param[in]   p2  A constant reference to the second point.
+         *
+         * @return      The distance between points `p1` and `p2`, a
+         *              floating point value of type `Real`.
+         *              If a path joining both points doesn't exist,
+         *              `CVX_INFTY'  is returned.
+         */
+        template< typename Type >
+        Real operator()(const Point_< Type >& p1,
+                        const Point_< Type >& p2) const {
+            return embedded(p1, p2);
+        }
+
+
+        /**
+         * @brief       Compute the distances from a 2D point to each point
+         *              of a structure-of-arrays (SoA) point set, with a
+         *              single sweep from `p`.
+         *
+         * @param[in]   p  A constant reference to the first point.
+         *
+         * @param[in]   xs  Contiguous array of abscissae.
+         *
+         * @param[in]   ys  Contiguous array of ordinates.
+         *
+         * @param[out]  out  Contiguous array receiving the `count`
+         *              distances.
+         *
+         * @param[in]   count  Number of points in `xs` and `ys`.
+         */
+        template< typename Type >
+        void batch(const Point_< Type >& p, const Real* xs, const Real* ys,
+                   Real* out, const unsigned count) const {
+            const FastMarching& f = field(pixel(p));
+            for (unsigned i = 0; i < count; ++i) {
+                out[i] = f.at(pixel(Point_< Real >(xs[i], ys[i])));
+            }
+        }
+
+
+        /**
+         * @brief       Compute the distances between each point of a SoA
+         *              point set and each point of another one, with one
+         *              sweep per point of the first set.
+         *
+         * @param[in]   xa  Contiguous array of abscissae of the first set.
+         *
+         * @param[in]   ya  Contiguous array of ordinates of the first set.
+         *
+         * @param[in]   na  Number of points in the first set.
+         *
+         * @param[in]   xb  Contiguous array of abscissae of the second set.
+         *
+         * @param[in]   yb  Contiguous array of ordinates of the second set.
+         *
+         * @param[in]   nb  Number of points in the second set.
+         *
+         * @param[out]  out  Output matrix, the distance between points `i`
+         *              and `j` is written to `out[i * stride + j]`.
+         *
+         * @param[in]   stride  Distance, in elements, between the rows of
+         *              `out`.
+         */
+        void batch(const Real* xa, const Real* ya, const unsigned na,
+                   const Real* xb, const Real* yb, const unsigned nb,
+                   Real* out, const size_t stride) const {
+            for (unsigned i = 0; i < na; ++i) {
+                batch(Point_< Real >(xa[i], ya[i]), xb, yb, out + i * stride, nb);
+            }
+        }
+
+
+    private:
+
+        /**
+         * @brief       Returns the distance map from a source pixel, the
+         *              one of the last call is reused.
+         */
+        const FastMarching& field(const Point& source) const {
+            if (not _valid or _marching.source() != source) {
+                _marching.run(*_map, source);
+                _valid = true;
+            }
+            return _marching;
+        }
+
+
+        /**
+         * @brief       Returns the pixel containing a 2D point.
+         */
+        template< typename Type >
+        static Point pixel(const Point_< Type >& p) {
+            return Point(static_cast< int > (std::floor(p.x + (Real) 0.5)),
+                         static_cast< int > (std::floor(p.y + (Real) 0.5)));
+        }
+
+
+    private:
+
+        std::shared_ptr< const PlanarSet > _map; /**< Connectivity map mask. */
+
+        mutable FastMarching _marching; /**< Distance map of the last source. */
+
+        mutable bool _valid; /**< The distance map has been computed. */
+
+    };
+
+
+} // namespace cvx
+
+
+#endif // CVX_METRIC_DISTANCE_GEODESIC_HPP__INCLUDED
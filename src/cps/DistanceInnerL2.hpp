@@ -0,0 +1,43 @@
+/**
+ * @file        DistanceInnerL2.hpp
+ *
+ * @brief       Defines inner-visibility L2 distance functor classes. Points
+ *              not seeing each other through the inside of a shape are at
+ *              infinite distance.
+ *
+ * This file is part of The Computer Vision Tools Project. It is subject to the
+ * license terms in the [LICENSE.md](../license/LICENSE.md) file found in the
+ * `licenses` sub-folder of the top-level directory of this distribution and at
+ * https://bitbucket.org/cpslccauna/CPSignature/license/LICENSE.md. No part of
+ * this project, including this file, may be copied, modified, propagated, or
+ * distributed except according to the terms contained in the above LICENSE
+ * file.
+ *
+ * See the [COPYING.md](../COPYING.md) file at the top-level directory of this
+ * distribution and at https://bitbucket.org/cpslccauna/CPSignature/COPYING.md
+ * for more legal information.
+ */
+
+#ifndef CVX_METRIC_DISTANCE_INNER_L2_HPP__INCLUDED
+#define CVX_METRIC_DISTANCE_INNER_L2_HPP__INCLUDED
+
+#pragma once
+
+#include "DistanceConnective.hpp"
+#include "ConnectorLineOfSight.hpp"
+#include "NormL2.hpp"
+
+
+namespace cvx {
+
+    /**
+     * @brief      Aliases for L2-norm based inner-visibility distance
+     *             functors.
+     */
+    typedef DistanceConnective_< NormL2, ConnectorLineOfSight > DistanceInnerL2,
+                                                                DistanceInnerEuclidean;
+
+}
+
+
+#endif // CVX_METRIC_DISTANCE_INNER_L2_HPP__INCLUDED
@@ -0,0 +1,245 @@
+/**
+ * @file        FastMarching.hpp
+ *
+ * @brief       Defines a fast marching solver for geodesic distance maps
+ *              within a planar set.
+ *
+ * This file is part of The Computer Vision Tools Project. It is subject to the
+ * license terms in the [LICENSE.md](../license/LICENSE.md) file found in the
+ * `licenses` sub-folder of the top-level directory of this distribution and at
+ * https://bitbucket.org/cpslccauna/CPSignature/license/LICENSE.md. No part of
+ * this project, including this file, may be copied, modified, propagated, or
+ * distributed except according to the terms contained in the above LICENSE
+ * file.
+ *
+ * See the [COPYING.md](../COPYING.md) file at the top-level directory of this
+ * distribution and at https://bitbucket.org/cpslccauna/CPSignature/COPYING.md
+ * for more legal information.
+ */
+
+#ifndef CVX_GEOMETRY_FAST_MARCHING_HPP__INCLUDED
+#define CVX_GEOMETRY_FAST_MARCHING_HPP__INCLUDED
+
+#pragma once
+
+#include "Imports.hpp"
+#include "Math.hpp"
+#include "PlanarSet.hpp"
+#include <algorithm>
+
+
+namespace cvx {
+
+    /**
+     * @class       FastMarching
+     *
+     * @brief       Geodesic distance maps within a planar set.
+     *
+     * @details     Objects of this class solve the eikonal equation, with
+     *              unit speed, over the pixels of a planar set, from a
+     *              single source pixel, using the fast marching method on
+     *              the 4-connected pixel grid. The result is the length of
+     *              the shortest path from the source to every pixel of the
+     *              set staying within it, i.e., the inner distance.
+     *
+     * @remark      The front is an untidy priority queue: a ring of buckets
+     *              `1 / RESOLUTION` units of arrival time wide, each one
+     *              settled in FIFO order. This makes a sweep linear in the
+     *              number of pixels, for an error of the order of the
+     *              bucket width.
+     *
+     * @remark      The distance map, the pixel states and the buckets are
+     *              kept between runs, so an object reused for several
+     *              sources does not allocate once the first run has sized
+     *              them. An object is not safe to share among threads, use
+     *              one per thread instead.
+     *
+     * @version     1.0
+     */
+    class FastMarching {
+
+    public:
+
+        /**
+         * @brief      Default constructor.
+         */
+        FastMarching() :
+        _width(0), _height(0), _current(0), _pending(0) {
+            // NOOP
+        }
+
+
+        /**
+         * @brief      Destructor.
+         */
+        ~FastMarching() {
+            // NOOP
+        }
+
+
+        /**
+         * @brief       Compute the geodesic distance map from a pixel.
+         *
+         * @param[in]   map  The planar set the paths are restricted to.
+         *
+         * @param[in]   source  The source pixel. If it is outside of the
+         *              set, every pixel is unreachable.
+         */
+        void run(const PlanarSet& map, const Point& source) {
+            _origin = map.origin();
+            _source = source;
+            _width = map.width();
+            _height = map.height();
+            const size_t size = (size_t) _width * (size_t) _height;
+            _time.assign(size, CVX_INFTY);
+            _known.assign(size, 0);
+            _buckets.resize(BUCKETS);
+            for (int b = 0; b < BUCKETS; ++b) {
+                _buckets[b].clear();
+            }
+            _current = 0;
+            _pending = 0;
+            if (not map.contains(source)) {
+                return;
+            }
+            push(index(source.x - _origin.x, source.y - _origin.y), 0);
+            while (_pending > 0) {
+                // The bucket may grow while it is being processed.
+                std::vector< int >& front = _buckets[_current % BUCKETS];
+                for (size_t k = 0; k < front.size(); ++k) {
+                    const int i = front[k];
+                    --_pending;
+                    if (_known[i]) {
+                        continue; // A stale entry, the pixel was settled before.
+                    }
+                    _known[i] = 1;
+                    const int x = i % _width, y = i / _width;
+                    visit(map, x - 1, y);
+                    visit(map, x + 1, y);
+                    visit(map, x, y - 1);
+                    visit(map, x, y + 1);
+                }
+                front.clear();
+                ++_current;
+            }
+        }
+
+
+        /**
+         * @brief   Returns the source pixel of the last run.
+         */
+        const Point& source() const {
+            return _source;
+        }
+
+
+        /**
+         * @brief       Returns the geodesic distance from the source to a
+         *              pixel, `CVX_INFTY` if it is not reachable.
+         *
+         * @param[in]   p  The pixel position.
+         */
+        Real at(const Point& p) const {
+            const int x = p.x - _origin.x, y = p.y - _origin.y;
+            if (x < 0 or y < 0 or x >= _width or y >= _height) {
+                return CVX_INFTY;
+            }
+            return _time[index(x, y)];
+        }
+
+
+    private:
+
+        /**
+         * @brief      Number of buckets per unit of arrival time.
+         */
+        static const int RESOLUTION = 8;
+
+        /**
+         * @brief      Number of buckets in the ring, an update is at most
+         *             one unit (one pixel step) ahead of the front.
+         */
+        static const int BUCKETS = 2 * RESOLUTION + 2;
+
+
+        int index(const int x, const int y) const {
+            return y * _width + x;
+        }
+
+
+        /**
+         * @brief       Queue a pixel with a (new) arrival time, in the
+         *              bucket of its time, never before the current one.
+         */
+        void push(const int i, const Real t) {
+            _time[i] = t;
+            const long b = std::max(_current, static_cast< long > (t * RESOLUTION));
+            _buckets[b % BUCKETS].push_back(i);
+            ++_pending;
+        }
+
+
+        /**
+         * @brief       Arrival time at a settled pixel, `CVX_INFTY` if it
+         *              is outside of the window or not settled yet.
+         */
+        Real known(const int x, const int y) const {
+            if (x < 0 or y < 0 or x >= _width or y >= _height) {
+                return CVX_INFTY;
+            }
+            const int i = index(x, y);
+            return _known[i] ? _time[i] : CVX_INFTY;
+        }
+
+
+        /**
+         * @brief       Update the arrival time at a neighbour of the front
+         *              with the upwind solution of the eikonal equation.
+         */
+        void visit(const PlanarSet& map, const int x, const int y) {
+            if (x < 0 or y < 0 or x >= _width or y >= _height) {
+                return;
+            }
+            const int i = index(x, y);
+            if (_known[i] or not map.contains(Point(x + _origin.x, y + _origin.y))) {
+                return;
+            }
+            Real a = std::min(known(x - 1, y), known(x + 1, y));
+            Real b = std::min(known(x, y - 1), known(x, y + 1));
+            if (a > b) {
+                std::swap(a, b);
+            }
+            // One-sided update when the other axis is too far behind.
+            const Real t = (b - a >= 1) ? a + 1
+                    : (a + b + std::sqrt(2 - (b - a) * (b - a))) / 2;
+            if (t < _time[i]) {
+                push(i, t);
+            }
+        }
+
+
+    private:
+
+        Point _origin; /**< Position of the top left pixel of the window. */
+
+        Point _source; /**< Source pixel of the last run. */
+
+        int _width, _height; /**< Size of the window. */
+
+        std::vector< Real > _time; /**< Arrival times (distance map). */
+
+        std::vector< uchar > _known; /**< Settled pixel flags. */
+
+        std::vector< std::vector< int > > _buckets; /**< Front, a ring of buckets. */
+
+        long _current; /**< Bucket being settled. */
+
+        size_t _pending; /**< Queued entries, stale ones included. */
+
+    };
+
+
+} // namespace cvx
+
+
+#endif // CVX_GEOMETRY_FAST_MARCHING_HPP__INCLUDED
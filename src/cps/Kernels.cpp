@@ -0,0 +1,177 @@
+/*
+ * File:   Kernels.cpp
+ *
+ * Run time selection of the kernel tables. The levels above SSE2 are only
+ * available when the build defines CVX_KERNELS_AVX2 / CVX_KERNELS_AVX512,
+ * i.e., when the compiler could build their translation units. The CPU is
+ * checked with `__builtin_cpu_supports` on GCC and Clang, and with `cpuid`
+ * and `xgetbv` on MSVC.
+ */
+
+#include "Kernels.hpp"
+#include <cstdlib>
+#include <cstring>
+#if defined(_MSC_VER) && !defined(__GNUC__) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+
+namespace cvx {
+
+    namespace sse2 {
+        void load(Kernels_< float >& k);
+        void load(Kernels_< double >& k);
+    }
+
+#if defined(CVX_KERNELS_AVX2)
+    namespace avx2 {
+        void load(Kernels_< float >& k);
+        void load(Kernels_< double >& k);
+    }
+#endif
+
+#if defined(CVX_KERNELS_AVX512)
+    namespace avx512 {
+        void load(Kernels_< float >& k);
+        void load(Kernels_< double >& k);
+    }
+#endif
+
+    namespace {
+
+        enum KernelsLevel {
+            LEVEL_SSE2 = 0,
+            LEVEL_AVX2 = 1,
+            LEVEL_AVX512 = 2
+        };
+
+#if defined(_MSC_VER) && !defined(__GNUC__) && (defined(_M_X64) || defined(_M_IX86))
+        /**
+         * @brief   Best level supported by the CPU and the operating system,
+         *          from `cpuid` and `xgetbv`, for the compilers without
+         *          `__builtin_cpu_supports`: the same features as the GCC
+         *          checks, and the register state enabled in XCR0 (YMM for
+         *          AVX2, YMM, opmask and ZMM for AVX-512).
+         */
+        int cpuidLevel() {
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] < 7) {
+                return LEVEL_SSE2;
+            }
+            __cpuid(info, 1);
+            const bool osxsave = (info[2] & (1 << 27)) != 0;
+            const bool fma = (info[2] & (1 << 12)) != 0;
+            if (!osxsave) {
+                return LEVEL_SSE2;
+            }
+            const unsigned long long xcr0 = _xgetbv(0);
+            __cpuidex(info, 7, 0);
+            const unsigned ebx = (unsigned) info[1];
+            int level = LEVEL_SSE2;
+            if ((xcr0 & 0x6) == 0x6 && fma && (ebx & (1u << 5))) {
+                level = LEVEL_AVX2;
+                const unsigned avx512 = (1u << 16) | (1u << 17) | (1u << 30) | (1u << 31);
+                if ((xcr0 & 0xe6) == 0xe6 && (ebx & avx512) == avx512) {
+                    level = LEVEL_AVX512;
+                }
+            }
+            return level;
+        }
+#endif
+
+        /**
+         * @brief   Best level compiled in and supported by the CPU (and by
+         *          the operating system, which must save the wider
+         *          registers).
+         */
+        int supportedLevel() {
+            int level = LEVEL_SSE2;
+#if defined(_MSC_VER) && !defined(__GNUC__) && (defined(_M_X64) || defined(_M_IX86))
+            const int detected = cpuidLevel();
+#if defined(CVX_KERNELS_AVX2)
+            if (detected >= LEVEL_AVX2) {
+                level = LEVEL_AVX2;
+            }
+#endif
+#if defined(CVX_KERNELS_AVX512)
+            if (detected >= LEVEL_AVX512) {
+                level = LEVEL_AVX512;
+            }
+#endif
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+            __builtin_cpu_init();
+#if defined(CVX_KERNELS_AVX2)
+            if (__builtin_cpu_supports("avx2") and __builtin_cpu_supports("fma")) {
+                level = LEVEL_AVX2;
+            }
+#endif
+#if defined(CVX_KERNELS_AVX512)
+            if (__builtin_cpu_supports("avx512f") and __builtin_cpu_supports("avx512dq")
+                    and __builtin_cpu_supports("avx512vl") and __builtin_cpu_supports("avx512bw")) {
+                level = LEVEL_AVX512;
+            }
+#endif
+#endif
+            return level;
+        }
+
+        /**
+         * @brief   Selected level: the supported one, lowered by the
+         *          `CVX_KERNELS` environment variable if set.
+         */
+        int selectedLevel() {
+            int level = supportedLevel();
+            const char* name = std::getenv("CVX_KERNELS");
+            if (name != 0) {
+                int requested = level;
+                if (std::strcmp(name, "sse2") == 0) {
+                    requested = LEVEL_SSE2;
+                } else if (std::strcmp(name, "avx2") == 0) {
+                    requested = LEVEL_AVX2;
+                } else if (std::strcmp(name, "avx512") == 0) {
+                    requested = LEVEL_AVX512;
+                }
+                level = (requested < level) ? requested : level;
+            }
+            return level;
+        }
+
+        template< typename Type >
+        Kernels_< Type > selectKernels() {
+            Kernels_< Type > k;
+            switch (selectedLevel()) {
+#if defined(CVX_KERNELS_AVX512)
+                case LEVEL_AVX512:
+                    avx512::load(k);
+                    break;
+#endif
+#if defined(CVX_KERNELS_AVX2)
+                case LEVEL_AVX2:
+                    avx2::load(k);
+                    break;
+#endif
+                default:
+                    sse2::load(k);
+                    break;
+            }
+            return k;
+        }
+
+    } // namespace
+
+    template< >
+    const Kernels_< float >& kernels< float >() {
+        static const Kernels_< float > k = selectKernels< float >();
+        return k;
+    }
+
+    template< >
+    const Kernels_< double >& kernels< double >() {
+        static const Kernels_< double > k = selectKernels< double >();
+        return k;
+    }
+
+
+} // namespace cvx
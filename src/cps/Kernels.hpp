@@ -0,0 +1,128 @@
+/**
+ * @file        Kernels.hpp
+ *
+ * @brief       Declares the table of hot numerical kernels, compiled once
+ *              per instruction set level and selected at run time.
+ *
+ * This file is part of The Computer Vision Tools Project. It is subject to the
+ * license terms in the [LICENSE.md](../license/LICENSE.md) file found in the
+ * `licenses` sub-folder of the top-level directory of this distribution and at
+ * https://bitbucket.org/cpslccauna/CPSignature/license/LICENSE.md. No part of
+ * this project, including this file, may be copied, modified, propagated, or
+ * distributed except according to the terms contained in the above LICENSE
+ * file.
+ *
+ * See the [COPYING.md](../COPYING.md) file at the top-level directory of this
+ * distribution and at https://bitbucket.org/cpslccauna/CPSignature/COPYING.md
+ * for more legal information.
+ */
+
+#ifndef CVX_UTIL_KERNELS_HPP__INCLUDED
+#define CVX_UTIL_KERNELS_HPP__INCLUDED
+
+#pragma once
+
+// Only standard headers here: this file is included by the translation
+// units compiled for each instruction set, which must not instantiate
+// inline code shared with the rest of the program.
+#include <cstddef>
+
+
+namespace cvx {
+
+    /**
+     * @struct      Kernels_< * >
+     *
+     * @brief       Table of the hot numerical kernels for one floating
+     *              point type.
+     *
+     * @details     The library compiles the kernels once per instruction set
+     *              level (SSE2, AVX2, AVX-512), see `kernels()`. All levels
+     *              return bit-identical results.
+     *
+     * @tparam      Type  The floating point type, `float` or `double`.
+     *
+     * @version     1.0
+     */
+    template< typename Type >
+    struct Kernels_ {
+
+        /**
+         * @brief   Signature run: `out[i]` is the euclidean distance from
+         *          `(x, y)` to `(xs[i], ys[i])` times `norm`, coincident
+         *          points counting as distance 1.
+         */
+        void (*cps_run)(Type x, Type y, const Type* xs, const Type* ys,
+                        Type* out, unsigned count, Type norm);
+
+        /**
+         * @brief   R measure between two signature rows of `n` values, the
+         *          last value of each row being ignored.
+         */
+        Type (*r_measure)(const Type* X, const Type* Y, unsigned n);
+
+        /**
+         * @brief   R measure between two signature rows of `n` values, using
+         *          their reciprocals (`iX[i] = 1 / X[i]`).
+         */
+        Type (*r_measure_inv)(const Type* X, const Type* iX, const Type* Y,
+                              const Type* iY, unsigned n);
+
+        /**
+         * @brief   `r_measure_inv` for the common sample counts: entry `k`
+         *          is compiled for rows of `16 << k` values (16 to 256),
+         *          with compile-time loop bounds, and ignores `n`. The
+         *          results are those of `r_measure_inv`.
+         */
+        Type (*r_measure_inv_fixed[5])(const Type* X, const Type* iX,
+                                       const Type* Y, const Type* iY,
+                                       unsigned n);
+
+        /**
+         * @brief   Cubic evaluation: `(xs[i], ys[i])` is the point of the
+         *          cubic segment at `ts[i]`. Coefficients are given from
+         *          the cubic to the independent term, `{a, b, c, d}`.
+         */
+        void (*cubic)(const Type* cx, const Type* cy, const Type* ts,
+                      Type* xs, Type* ys, unsigned count);
+
+        /**
+         * @brief   Chord lengths of a polyline of `count` vertices: `out[i]`
+         *          is the length from vertex `i` to vertex `i + 1`.
+         */
+        void (*chords)(const Type* xs, const Type* ys, Type* out,
+                       unsigned count);
+
+        /**
+         * @brief   Name of the instruction set level of the table.
+         */
+        const char* isa;
+
+    };
+
+
+    /**
+     * @brief       Returns the kernel table of the best instruction set level
+     *              supported by the running CPU.
+     *
+     * @details     Each level is compiled with its own target flags, so a
+     *              single binary runs at full speed on every machine. The
+     *              level is detected on the first call. It can be
+     *              lowered with the `CVX_KERNELS` environment variable, set to
+     *              `sse2`, `avx2` or `avx512`; levels that are not supported
+     *              by the CPU, or that were not compiled, are ignored.
+     */
+    template< typename Type >
+    const Kernels_< Type >& kernels();
+
+    template< >
+    const Kernels_< float >& kernels< float >();
+
+    template< >
+    const Kernels_< double >& kernels< double >();
+
+
+} // namespace cvx
+
+
+#endif // CVX_UTIL_KERNELS_HPP__INCLUDED
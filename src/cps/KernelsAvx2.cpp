@@ -0,0 +1,27 @@
+/* 
+ * File:   KernelsAvx2.cpp
+ *
+ * Kernels compiled for the AVX2 instruction set level.
+ */
+
+#define CVX_KERNELS_ISA avx2
+
+#include "KernelsImpl.hpp"
+
+
+namespace cvx {
+
+    namespace avx2 {
+
+        void load(Kernels_< float >& k) {
+            load(k, "avx2");
+        }
+
+        void load(Kernels_< double >& k) {
+            load(k, "avx2");
+        }
+
+    } // namespace avx2
+
+
+} // namespace cvx
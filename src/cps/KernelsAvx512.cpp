@@ -0,0 +1,27 @@
+/* 
+ * File:   KernelsAvx512.cpp
+ *
+ * Kernels compiled for the AVX-512 instruction set level.
+ */
+
+#define CVX_KERNELS_ISA avx512
+
+#include "KernelsImpl.hpp"
+
+
+namespace cvx {
+
+    namespace avx512 {
+
+        void load(Kernels_< float >& k) {
+            load(k, "avx512");
+        }
+
+        void load(Kernels_< double >& k) {
+            load(k, "avx512");
+        }
+
+    } // namespace avx512
+
+
+} // namespace cvx
@@ -0,0 +1,295 @@
+/**
+ * @file        KernelsImpl.hpp
+ *
+ * @brief       Implements the hot numerical kernels, once per instruction
+ *              set level.
+ *
+ * @details     This file is included by a translation unit per level, each
+ *              one compiled with its own target flags and defining
+ *              CVX_KERNELS_ISA to the namespace of the level. The loops are
+ *              plain C++ written for the auto-vectorizer: element-wise, and
+ *              with the sums split in compensated lanes, so no floating
+ *              point reassociation is needed and every level gives the same
+ *              results.
+ *
+ * This file is part of The Computer Vision Tools Project. It is subject to the
+ * license terms in the [LICENSE.md](../license/LICENSE.md) file found in the
+ * `licenses` sub-folder of the top-level directory of this distribution and at
+ * https://bitbucket.org/cpslccauna/CPSignature/license/LICENSE.md. No part of
+ * this project, including this file, may be copied, modified, propagated, or
+ * distributed except according to the terms contained in the above LICENSE
+ * file.
+ *
+ * See the [COPYING.md](../COPYING.md) file at the top-level directory of this
+ * distribution and at https://bitbucket.org/cpslccauna/CPSignature/COPYING.md
+ * for more legal information.
+ */
+
+#ifndef CVX_UTIL_KERNELS_IMPL_HPP__INCLUDED
+#define CVX_UTIL_KERNELS_IMPL_HPP__INCLUDED
+
+#pragma once
+
+#if !defined(CVX_KERNELS_ISA)
+#error "Define CVX_KERNELS_ISA before including KernelsImpl.hpp"
+#endif
+
+#include "Kernels.hpp"
+#include <cmath>
+
+
+namespace cvx {
+
+    namespace CVX_KERNELS_ISA {
+
+        namespace {
+
+            /**
+             * @brief   Number of independent sums, as many as `float`
+             *          values in the widest register.
+             */
+            const unsigned LANES = 16;
+
+            /**
+             * @brief   Values per block of the r measure, a multiple of
+             *          `LANES`.
+             */
+            const unsigned BLOCK = 64;
+
+
+            /**
+             * @brief   Adds `LANES` values to `LANES` sums with Kahan
+             *          compensation, element-wise.
+             */
+            template< typename Type >
+            inline void add_lanes(Type* sum, Type* cmp, const Type* v) {
+                for (unsigned l = 0; l < LANES; ++l) {
+                    const Type y = v[l] - cmp[l];
+                    const Type t = sum[l] + y;
+                    cmp[l] = (t - sum[l]) - y;
+                    sum[l] = t;
+                }
+            }
+
+
+            /**
+             * @brief   Total of the compensated lanes, added pairwise.
+             */
+            template< typename Type >
+            inline Type total_lanes(const Type* sum, const Type* cmp) {
+                Type s[LANES];
+                for (unsigned l = 0; l < LANES; ++l) {
+                    s[l] = sum[l] - cmp[l];
+                }
+                for (unsigned w = LANES / 2; w > 0; w /= 2) {
+                    for (unsigned l = 0; l < w; ++l) {
+                        s[l] += s[l + w];
+                    }
+                }
+                return s[0];
+            }
+
+
+            /**
+             * @brief   R measure of two rows of `n` values, the ratios of
+             *          each block of values being computed by `ratios(s, m,
+             *          c1, c2)`, for the `m` values from `s`.
+             *
+             * @details The ratios are padded with a 1 at each end, and the
+             *          differences of consecutive ratios are added in
+             *          compensated lanes (see `add_lanes()`).
+             */
+            template< typename Type, typename Ratios >
+            inline Type r_measure_blocks(const Ratios& ratios, const unsigned n) {
+                Type c1[BLOCK + 1], c2[BLOCK + 1], d1[BLOCK], d2[BLOCK];
+                Type s1[LANES], k1[LANES], s2[LANES], k2[LANES];
+                for (unsigned l = 0; l < LANES; ++l) {
+                    s1[l] = k1[l] = s2[l] = k2[l] = 0;
+                }
+                c1[0] = c2[0] = 1;
+                const unsigned N = (n > 0) ? n - 1 : 0;
+                for (unsigned s = 0; s < N; s += BLOCK) {
+                    const unsigned m = (N - s < BLOCK) ? N - s : BLOCK;
+                    ratios(s, m, c1 + 1, c2 + 1);
+                    for (unsigned l = 0; l < m; ++l) {
+                        d1[l] = std::abs(c1[l + 1] - c1[l]);
+                        d2[l] = std::abs(c2[l + 1] - c2[l]);
+                    }
+                    const unsigned e = (m + LANES - 1) / LANES * LANES;
+                    for (unsigned l = m; l < e; ++l) {
+                        d1[l] = d2[l] = 0;
+                    }
+                    if (s == 0) {
+                        // The end differences weight a half (trapezoid).
+                        d1[0] *= (Type) 0.5;
+                        d2[0] *= (Type) 0.5;
+                    }
+                    for (unsigned l = 0; l < e; l += LANES) {
+                        add_lanes(s1, k1, d1 + l);
+                        add_lanes(s2, k2, d2 + l);
+                    }
+                    c1[0] = c1[m];
+                    c2[0] = c2[m];
+                }
+                const Type e1 = (Type) 0.5 * std::abs(c1[0] - 1);
+                const Type e2 = (Type) 0.5 * std::abs(c2[0] - 1);
+                return (total_lanes(s1, k1) + e1) * (total_lanes(s2, k2) + e2);
+            }
+
+
+            /**
+             * @brief   Ratios `X / Y` and `Y / X`.
+             */
+            template< typename Type >
+            struct Ratios_ {
+                const Type* X;
+                const Type* Y;
+
+                void operator()(const unsigned s, const unsigned m, Type* c1, Type* c2) const {
+                    for (unsigned l = 0; l < m; ++l) {
+                        c1[l] = X[s + l] / Y[s + l];
+                        c2[l] = Y[s + l] / X[s + l];
+                    }
+                }
+            };
+
+
+            template< typename Type >
+            void cps_run(Type x, Type y, const Type* xs, const Type* ys,
+                         Type* out, unsigned count, Type norm) {
+                for (unsigned i = 0; i < count; ++i) {
+                    const Type dx = xs[i] - x, dy = ys[i] - y;
+                    const Type d = std::sqrt(dx * dx + dy * dy);
+                    out[i] = (d == 0 ? (Type) 1 : d) * norm;
+                }
+            }
+
+
+            template< typename Type >
+            Type r_measure(const Type* X, const Type* Y, unsigned n) {
+                const Ratios_< Type > ratios = {X, Y};
+                return r_measure_blocks< Type >(ratios, n);
+            }
+
+
+            /**
+             * @details One pass over the rows with multiplications only: the
+             *          differences of consecutive ratios are recomputed from
+             *          the inputs instead of being kept, so there is no
+             *          buffer. The values go to the same lanes, in the same
+             *          order, as in `r_measure_blocks()`. `Size`, when not
+             *          zero, replaces `n`, so the loops have compile-time
+             *          bounds.
+             */
+            template< typename Type, unsigned Size = 0 >
+            Type r_measure_inv(const Type* X, const Type* iX, const Type* Y,
+                               const Type* iY, unsigned n) {
+                if (Size > 0) {
+                    n = Size;
+                }
+                Type s1[LANES], k1[LANES], s2[LANES], k2[LANES];
+                Type d1[LANES], d2[LANES];
+                for (unsigned l = 0; l < LANES; ++l) {
+                    s1[l] = k1[l] = s2[l] = k2[l] = 0;
+                }
+                const unsigned N = (n > 0) ? n - 1 : 0;
+                if (N == 0) {
+                    return 0;
+                }
+
+                // First chunk: the ratios are preceded by a 1, and the first
+                // difference weights a half (trapezoid).
+                const unsigned h = (N < LANES) ? N : LANES;
+                d1[0] = (Type) 0.5 * std::abs(X[0] * iY[0] - 1);
+                d2[0] = (Type) 0.5 * std::abs(Y[0] * iX[0] - 1);
+                for (unsigned l = 1; l < LANES; ++l) {
+                    d1[l] = (l < h) ? std::abs(X[l] * iY[l] - X[l - 1] * iY[l - 1]) : 0;
+                    d2[l] = (l < h) ? std::abs(Y[l] * iX[l] - Y[l - 1] * iX[l - 1]) : 0;
+                }
+                add_lanes(s1, k1, d1);
+                add_lanes(s2, k2, d2);
+
+                // Full chunks.
+                unsigned g = LANES;
+                for (; g + LANES <= N; g += LANES) {
+                    // Rows from g, and from the value before g.
+                    const Type *x = X + g, *ix = iX + g, *y = Y + g, *iy = iY + g;
+                    const Type *px = x - 1, *pix = ix - 1, *py = y - 1, *piy = iy - 1;
+                    for (unsigned l = 0; l < LANES; ++l) {
+                        d1[l] = std::abs(x[l] * iy[l] - px[l] * piy[l]);
+                        d2[l] = std::abs(y[l] * ix[l] - py[l] * pix[l]);
+                    }
+                    add_lanes(s1, k1, d1);
+                    add_lanes(s2, k2, d2);
+                }
+
+                // Last, partial chunk.
+                if (g < N) {
+                    for (unsigned l = 0; l < LANES; ++l) {
+                        const unsigned i = (g + l < N) ? g + l : g;
+                        d1[l] = (g + l < N) ? std::abs(X[i] * iY[i] - X[i - 1] * iY[i - 1]) : 0;
+                        d2[l] = (g + l < N) ? std::abs(Y[i] * iX[i] - Y[i - 1] * iX[i - 1]) : 0;
+                    }
+                    add_lanes(s1, k1, d1);
+                    add_lanes(s2, k2, d2);
+                }
+
+                // The ratios are followed by a 1.
+                const Type e1 = (Type) 0.5 * std::abs(X[N - 1] * iY[N - 1] - 1);
+                const Type e2 = (Type) 0.5 * std::abs(Y[N - 1] * iX[N - 1] - 1);
+                return (total_lanes(s1, k1) + e1) * (total_lanes(s2, k2) + e2);
+            }
+
+
+            template< typename Type >
+            void cubic(const Type* cx, const Type* cy, const Type* ts,
+                       Type* xs, Type* ys, unsigned count) {
+                for (unsigned i = 0; i < count; ++i) {
+                    const Type t = ts[i], t2 = t * t, t3 = t2 * t;
+                    xs[i] = cx[0] * t3 + cx[1] * t2 + cx[2] * t + cx[3];
+                    ys[i] = cy[0] * t3 + cy[1] * t2 + cy[2] * t + cy[3];
+                }
+            }
+
+
+            template< typename Type >
+            void chords(const Type* xs, const Type* ys, Type* out,
+                        unsigned count) {
+                for (unsigned i = 0; i + 1 < count; ++i) {
+                    const Type dx = xs[i + 1] - xs[i], dy = ys[i + 1] - ys[i];
+                    out[i] = std::sqrt(dx * dx + dy * dy);
+                }
+            }
+
+        } // namespace
+
+
+        /**
+         * @brief       Fills a kernel table with the kernels of this level.
+         */
+        template< typename Type >
+        void load(Kernels_< Type >& k, const char* isa) {
+            k.cps_run = &cps_run< Type >;
+            k.r_measure = &r_measure< Type >;
+            k.r_measure_inv = &r_measure_inv< Type >;
+            k.r_measure_inv_fixed[0] = &r_measure_inv< Type, 16 >;
+            k.r_measure_inv_fixed[1] = &r_measure_inv< Type, 32 >;
+            k.r_measure_inv_fixed[2] = &r_measure_inv< Type, 64 >;
+            k.r_measure_inv_fixed[3] = &r_measure_inv< Type, 128 >;
+            k.r_measure_inv_fixed[4] = &r_measure_inv< Type, 256 >;
+            k.cubic = &cubic< Type >;
+            k.chords = &chords< Type >;
+            k.isa = isa;
+        }
+
+        void load(Kernels_< float >& k);
+
+        void load(Kernels_< double >& k);
+
+    } // namespace CVX_KERNELS_ISA
+
+
+} // namespace cvx
+
+
+#endif // CVX_UTIL_KERNELS_IMPL_HPP__INCLUDED
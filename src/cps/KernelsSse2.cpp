@@ -0,0 +1,27 @@
+/* 
+ * File:   KernelsSse2.cpp
+ *
+ * Kernels compiled for the SSE2 instruction set level.
+ */
+
+#define CVX_KERNELS_ISA sse2
+
+#include "KernelsImpl.hpp"
+
+
+namespace cvx {
+
+    namespace sse2 {
+
+        void load(Kernels_< float >& k) {
+            load(k, "sse2");
+        }
+
+        void load(Kernels_< double >& k) {
+            load(k, "sse2");
+        }
+
+    } // namespace sse2
+
+
+} // namespace cvx
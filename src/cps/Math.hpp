@@ -68,6 +68,72 @@
 #define CVX_INFTY CVX_INFTY_(cvx::Real)
 
 
+namespace cvx {
+
+    /**
+     * Computes `x^P` for a compile-time integer exponent `P`, by
+     * repeated squaring, i.e., with about `log2(P)` multiplications.
+     */
+    template< unsigned int P >
+    struct IntPow_ {
+        static Real eval(const Real x) {
+            const Real h = IntPow_< P / 2 >::eval(x);
+            return (P % 2 == 0) ? h * h : h * h * x;
+        }
+    };
+
+    template<>
+    struct IntPow_< 1 > {
+        static Real eval(const Real x) {
+            return x;
+        }
+    };
+
+    template<>
+    struct IntPow_< 0 > {
+        static Real eval(const Real) {
+            return 1;
+        }
+    };
+
+
+    /**
+     * Computes the `P`-th root of `x`, for a compile-time integer `P`.
+     * Even roots are computed by nested square roots, `P = 3` by the
+     * cubic root; `std::pow` is only used for other odd degrees.
+     */
+    template< unsigned int P, bool Even = (P % 2 == 0) >
+    struct IntRoot_ {
+        static Real eval(const Real x) {
+            return std::pow(x, (Real) 1 / (Real) P);
+        }
+    };
+
+    template< unsigned int P >
+    struct IntRoot_< P, true > {
+        static Real eval(const Real x) {
+            return std::sqrt(IntRoot_< P / 2 >::eval(x));
+        }
+    };
+
+    template<>
+    struct IntRoot_< 3, false > {
+        static Real eval(const Real x) {
+            return std::cbrt(x);
+        }
+    };
+
+    template<>
+    struct IntRoot_< 1, false > {
+        static Real eval(const Real x) {
+            return x;
+        }
+    };
+
+
+} // namespace cvx
+
+
 /**
  * To avoid overflow or underflow at intermediate stages
  * of the computation, define CVX_MATH_USING_STD_HYPOT.
@@ -128,13 +194,14 @@ namespace cvx {
      */
     template< typename Type, unsigned int P > inline
     Real norm_lp(const Point_< Type >& p) {
-        static const Real q = (Real) 1 / (Real) P;
-        Real cx = std::abs(p.x);
-        Real cy = std::abs(p.y);
-        const Real n = std::max(cx, cy);
-        cx = std::pow(cx / n, (Real) P);
-        cy = std::pow(cy / n, (Real) P);
-        return n * std::pow(cx + cy, q);
+        const Real cx = std::abs((Real) p.x);
+        const Real cy = std::abs((Real) p.y);
+        const Real hi = std::max(cx, cy);
+        const Real lo = std::min(cx, cy);
+        // Only the smaller cathetus is scaled, (lo / hi)^P <= 1; a null
+        // vector gives t = 0, and so a null norm, without branching.
+        const Real t = lo / (hi > 0 ? hi : (Real) 1);
+        return hi * IntRoot_< P >::eval(1 + IntPow_< P >::eval(t));
     }
 
 
@@ -192,12 +259,9 @@ namespace cvx {
      */
     template< typename Type, unsigned int P > inline
     Real norm_lp(const Point_< Type >& p) {
-        static const Real q = (Real) 1 / (Real) P;
-        Real cx = std::abs(p.x);
-        Real cy = std::abs(p.y);
-        cx = std::pow(cx, (Real) P);
-        cy = std::pow(cy, (Real) P);
-        return std::pow(cx + cy, q);
+        const Real cx = std::abs((Real) p.x);
+        const Real cy = std::abs((Real) p.y);
+        return IntRoot_< P >::eval(IntPow_< P >::eval(cx) + IntPow_< P >::eval(cy));
     }
 
 
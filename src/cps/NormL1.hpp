@@ -69,6 +69,33 @@ namespace cvx {
         }
 
 
+        /**
+         * @brief       Compute the norms of the vectors from a point to each
+         *              point of a structure-of-arrays (SoA) point set.
+         *
+         * @details     The loop is branch-free over contiguous arrays, so it
+         *              is vectorized by the compiler.
+         *
+         * @param[in]   px  Abscissa of the origin point.
+         *
+         * @param[in]   py  Ordinate of the origin point.
+         *
+         * @param[in]   xs  Contiguous array of abscissae.
+         *
+         * @param[in]   ys  Contiguous array of ordinates.
+         *
+         * @param[out]  out  Contiguous array receiving the `count` norms.
+         *
+         * @param[in]   count  Number of points.
+         */
+        void batch(const Real px, const Real py, const Real* xs,
+                   const Real* ys, Real* out, const unsigned count) const {
+            for (unsigned i = 0; i < count; ++i) {
+                out[i] = std::abs(xs[i] - px) + std::abs(ys[i] - py);
+            }
+        }
+
+
     private:
 
         template< typename PointType > static
@@ -68,6 +68,34 @@ namespace cvx {
         }
 
 
+        /**
+         * @brief       Compute the norms of the vectors from a point to each
+         *              point of a structure-of-arrays (SoA) point set.
+         *
+         * @details     The loop is branch-free over contiguous arrays, so it
+         *              is vectorized by the compiler.
+         *
+         * @param[in]   px  Abscissa of the origin point.
+         *
+         * @param[in]   py  Ordinate of the origin point.
+         *
+         * @param[in]   xs  Contiguous array of abscissae.
+         *
+         * @param[in]   ys  Contiguous array of ordinates.
+         *
+         * @param[out]  out  Contiguous array receiving the `count` norms.
+         *
+         * @param[in]   count  Number of points.
+         */
+        void batch(const Real px, const Real py, const Real* xs,
+                   const Real* ys, Real* out, const unsigned count) const {
+            for (unsigned i = 0; i < count; ++i) {
+                const Real dx = xs[i] - px, dy = ys[i] - py;
+                out[i] = std::sqrt(dx * dx + dy * dy);
+            }
+        }
+
+
     private:
 
         template< typename PointType > static
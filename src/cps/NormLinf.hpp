@@ -0,0 +1,112 @@
+/**
+ * @file        NormLinf.hpp
+ *
+ * @brief       Defines a L∞ norm functor template class.
+ *
+ * This file is part of The Computer Vision Tools Project. It is subject to the
+ * license terms in the [LICENSE.md](../license/LICENSE.md) file found in the
+ * `licenses` sub-folder of the top-level directory of this distribution and at
+ * https://bitbucket.org/cpslccauna/CPSignature/license/LICENSE.md. No part of
+ * this project, including this file, may be copied, modified, propagated, or
+ * distributed except according to the terms contained in the above LICENSE
+ * file.
+ *
+ * See the [COPYING.md](../COPYING.md) file at the top-level directory of this
+ * distribution and at https://bitbucket.org/cpslccauna/CPSignature/COPYING.md
+ * for more legal information.
+ */
+
+#ifndef CVX_METRIC_NORM_LINF_HPP__INCLUDED
+#define CVX_METRIC_NORM_LINF_HPP__INCLUDED
+
+#pragma once
+
+#include "NormLp.hpp"
+
+
+namespace cvx {
+
+    /**
+     * @class       NormLp_< 0 >
+     *
+     * @brief       Template class for L∞ (also kown as Chebyshev, chessboard,
+     *              or maximum) norm functor objects.
+     *
+     * @details     Objects instantiated from this class computes the distance
+     *              between a point and the origin, or the length of a vector,
+     *              using the L∞ norm.
+     *
+     * @remark      Since a degree of 0 does not define a norm, the degree 0
+     *              is reserved for the limiting case of the Lp norm when `p`
+     *              tends to infinity.
+     *
+     * @version     1.0
+     */
+    template<>
+    class NormLp_< 0 > {
+
+    public:
+
+        // Use default cannon for constructors, destructor, and assignment.
+
+        /**
+         * @brief       Compute the norm of a 2D vector.
+         *
+         * @param[in]   v  A constant reference to the 2D vector.
+         *
+         * @return      The norm of vector `v`, a floating point value
+         *              of type `Real`.
+         */
+        template< typename Type >
+        Real operator()(const Point_< Type >& v) const {
+            return normInf_2(v);
+        }
+
+
+        /**
+         * @brief       Compute the norms of the vectors from a point to each
+         *              point of a structure-of-arrays (SoA) point set.
+         *
+         * @details     The loop is branch-free over contiguous arrays, so it
+         *              is vectorized by the compiler.
+         *
+         * @param[in]   px  Abscissa of the origin point.
+         *
+         * @param[in]   py  Ordinate of the origin point.
+         *
+         * @param[in]   xs  Contiguous array of abscissae.
+         *
+         * @param[in]   ys  Contiguous array of ordinates.
+         *
+         * @param[out]  out  Contiguous array receiving the `count` norms.
+         *
+         * @param[in]   count  Number of points.
+         */
+        void batch(const Real px, const Real py, const Real* xs,
+                   const Real* ys, Real* out, const unsigned count) const {
+            for (unsigned i = 0; i < count; ++i) {
+                out[i] = std::max(std::abs(xs[i] - px), std::abs(ys[i] - py));
+            }
+        }
+
+
+    private:
+
+        template< typename PointType > static
+        Real normInf_2(const PointType& p) {
+            return static_cast< Real > (std::max(std::abs(p.x), std::abs(p.y)));
+        }
+
+    };
+
+
+    /**
+     * @brief      Aliases for NormLp_< 0 >.
+     */
+    typedef NormLp_< 0 > NormLinf, NormChebyshev, NormMaximum;
+
+
+} // namespace cvx
+
+
+#endif // CVX_METRIC_NORM_LINF_HPP__INCLUDED
@@ -52,7 +52,8 @@ namespace cvx {
      *              metaclasses and classes, i.e., it defines the interface for
      *              norm functors. Each implementation of a norm functor class
      *              **must** have, at least, a default constructor, destructor,
-     *              and the function call `operator()` for 2D vectors.
+     *              the function call `operator()` for 2D vectors, and the
+     *              `batch()` member for structure-of-arrays point sets.
      *
      * @remark      Special cases requiring additional information can have
      *              additional constructors, methods and data members as
@@ -89,7 +90,35 @@ namespace cvx {
          */
         template< typename Type >
         Real operator()(const Point_< Type >& v) const {
-            return normP_2<Type, P>(v);
+            return normP_2(v);
+        }
+
+
+        /**
+         * @brief       Compute the norms of the vectors from a point to each
+         *              point of a structure-of-arrays (SoA) point set.
+         *
+         * @details     Generic implementation, it calls the scalar norm for
+         *              each point. Specializations override it with loops
+         *              the compiler can vectorize.
+         *
+         * @param[in]   px  Abscissa of the origin point.
+         *
+         * @param[in]   py  Ordinate of the origin point.
+         *
+         * @param[in]   xs  Contiguous array of abscissae.
+         *
+         * @param[in]   ys  Contiguous array of ordinates.
+         *
+         * @param[out]  out  Contiguous array receiving the `count` norms.
+         *
+         * @param[in]   count  Number of points.
+         */
+        void batch(const Real px, const Real py, const Real* xs,
+                   const Real* ys, Real* out, const unsigned count) const {
+            for (unsigned i = 0; i < count; ++i) {
+                out[i] = normP_2(Point_< Real >(xs[i] - px, ys[i] - py));
+            }
         }
 
 
@@ -0,0 +1,450 @@
+/**
+ * @file        PlanarSet.hpp
+ *
+ * @brief       Defines a bit-packed planar point set (a shape mask) with
+ *              fast rectangle and straight line containment queries.
+ *
+ * This file is part of The Computer Vision Tools Project. It is subject to the
+ * license terms in the [LICENSE.md](../license/LICENSE.md) file found in the
+ * `licenses` sub-folder of the top-level directory of this distribution and at
+ * https://bitbucket.org/cpslccauna/CPSignature/license/LICENSE.md. No part of
+ * this project, including this file, may be copied, modified, propagated, or
+ * distributed except according to the terms contained in the above LICENSE
+ * file.
+ *
+ * See the [COPYING.md](../COPYING.md) file at the top-level directory of this
+ * distribution and at https://bitbucket.org/cpslccauna/CPSignature/COPYING.md
+ * for more legal information.
+ */
+
+#ifndef CVX_GEOMETRY_PLANAR_SET_HPP__INCLUDED
+#define CVX_GEOMETRY_PLANAR_SET_HPP__INCLUDED
+
+#pragma once
+
+#include "Imports.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+
+namespace cvx {
+
+    /**
+     * @class       PlanarSet
+     *
+     * @brief       Bit-packed planar point set.
+     *
+     * @details     Objects of this class hold a shape mask, i.e., the set of
+     *              pixels lying inside a shape, packed 64 pixels per word,
+     *              both row by row and column by column, together with the
+     *              integral image of the mask. The integral image answers
+     *              rectangle queries in constant time, and the packed rows
+     *              (columns) check whole horizontal (vertical) runs of a
+     *              digital straight line a word at a time.
+     *
+     * @remark      The mask may cover only a window of the plane, whose top
+     *              left corner is given by `origin`; points outside of the
+     *              window are outside of the set.
+     *
+     * @version     1.0
+     */
+    class PlanarSet {
+
+    public:
+
+        /**
+         * @brief      A type for packed bitmap words.
+         */
+        typedef std::uint64_t word_t;
+
+
+    public:
+
+        /**
+         * @brief      Default constructor.
+         */
+        PlanarSet() :
+        _width(0), _height(0), _rowWords(0), _colWords(0) {
+            // NOOP
+        }
+
+
+        /**
+         * @brief       Copy constructor.
+         *
+         * @param[in]   src  A planar set.
+         */
+        PlanarSet(const PlanarSet& src) :
+        _origin(src._origin),
+        _width(src._width), _height(src._height),
+        _rowWords(src._rowWords), _colWords(src._colWords),
+        _rows(src._rows), _cols(src._cols),
+        _sum(src._sum) {
+            // NOOP
+        }
+
+
+        /**
+         * @brief       Move constructor.
+         *
+         * @param[in]   src  A planar set.
+         */
+        PlanarSet(PlanarSet&& src) :
+        _origin(src._origin),
+        _width(src._width), _height(src._height),
+        _rowWords(src._rowWords), _colWords(src._colWords),
+        _rows(std::move(src._rows)), _cols(std::move(src._cols)),
+        _sum(std::move(src._sum)) {
+            // NOOP
+        }
+
+
+        /**
+         * @brief       Normal constructor.
+         *
+         * @param[in]   mask  A 8-bit single channel mask, non-zero pixels
+         *              belong to the set.
+         *
+         * @param[in]   origin  Position of the top left pixel of the mask.
+         */
+        explicit PlanarSet(const Mat& mask, const Point& origin = Point(0, 0)) :
+        _width(0), _height(0), _rowWords(0), _colWords(0) {
+            set(mask, origin);
+        }
+
+
+        /**
+         * @brief      Destructor.
+         */
+        ~PlanarSet() {
+            // NOOP
+        }
+
+
+        /**
+         * @brief       Copy assignment operator.
+         *
+         * @param[in]   src  A planar set.
+         */
+        PlanarSet& operator=(const PlanarSet& src) {
+            return assign(src);
+        }
+
+
+        /**
+         * @brief       Move assignment operator.
+         *
+         * @param[in]   src  A planar set.
+         */
+        PlanarSet& operator=(PlanarSet&& src) {
+            return assign(std::move(src));
+        }
+
+
+        /**
+         * @brief       Copy assignment.
+         *
+         * @param[in]   src  A planar set.
+         */
+        PlanarSet& assign(const PlanarSet& src) {
+            _origin = src._origin;
+            _width = src._width;
+            _height = src._height;
+            _rowWords = src._rowWords;
+            _colWords = src._colWords;
+            _rows = src._rows;
+            _cols = src._cols;
+            _sum = src._sum;
+            return *this;
+        }
+
+
+        /**
+         * @brief       Move assignment.
+         *
+         * @param[in]   src  A planar set.
+         */
+        PlanarSet& assign(PlanarSet&& src) {
+            _origin = src._origin;
+            _width = src._width;
+            _height = src._height;
+            _rowWords = src._rowWords;
+            _colWords = src._colWords;
+            _rows = std::move(src._rows);
+            _cols = std::move(src._cols);
+            _sum = std::move(src._sum);
+            return *this;
+        }
+
+
+        /**
+         * @brief       Setter.
+         *
+         * @param[in]   mask  A 8-bit single channel mask, non-zero pixels
+         *              belong to the set.
+         *
+         * @param[in]   origin  Position of the top left pixel of the mask.
+         */
+        void set(const Mat& mask, const Point& origin = Point(0, 0)) {
+            CV_Assert(mask.type() == CV_8U);
+            _origin = origin;
+            _width = mask.cols;
+            _height = mask.rows;
+            _rowWords = (_width + 63) / 64;
+            _colWords = (_height + 63) / 64;
+            _rows.assign(_rowWords * _height, 0);
+            _cols.assign(_colWords * _width, 0);
+            // Unit mask, so the integral image counts pixels.
+            Mat unit(_height, _width, CV_8U);
+            for (int y = 0; y < _height; ++y) {
+                const uchar* src = mask.ptr(y);
+                uchar* dst = unit.ptr(y);
+                for (int x = 0; x < _width; ++x) {
+                    dst[x] = (src[x] != 0) ? 1 : 0;
+                    if (dst[x]) {
+                        _rows[y * _rowWords + (x >> 6)] |= (word_t) 1 << (x & 63);
+                        _cols[x * _colWords + (y >> 6)] |= (word_t) 1 << (y & 63);
+                    }
+                }
+            }
+            integral(unit, _sum, CV_32S);
+        }
+
+
+        /**
+         * @brief   Returns the width of the mask window.
+         */
+        int width() const {
+            return _width;
+        }
+
+
+        /**
+         * @brief   Returns the height of the mask window.
+         */
+        int height() const {
+            return _height;
+        }
+
+
+        /**
+         * @brief   Returns the position of the top left pixel of the
+         *          mask window.
+         */
+        const Point& origin() const {
+            return _origin;
+        }
+
+
+        /**
+         * @brief   Check if the set has no mask.
+         */
+        bool empty() const {
+            return _width == 0 or _height == 0;
+        }
+
+
+        /**
+         * @brief       Check if a pixel belongs to the set.
+         *
+         * @param[in]   p  The pixel position.
+         */
+        bool contains(const Point& p) const {
+            const int x = p.x - _origin.x, y = p.y - _origin.y;
+            if (x < 0 or y < 0 or x >= _width or y >= _height) {
+                return false;
+            }
+            return (_rows[y * _rowWords + (x >> 6)] >> (x & 63)) & 1;
+        }
+
+
+        /**
+         * @brief       Counts the pixels of a rectangle belonging to the
+         *              set, in constant time.
+         *
+         * @param[in]   r  The rectangle, pixels outside of the mask window
+         *              are not counted.
+         */
+        int count(const Rect& r) const {
+            const int x0 = std::max(r.x - _origin.x, 0);
+            const int y0 = std::max(r.y - _origin.y, 0);
+            const int x1 = std::min(r.x - _origin.x + r.width, _width);
+            const int y1 = std::min(r.y - _origin.y + r.height, _height);
+            if (x0 >= x1 or y0 >= y1) {
+                return 0;
+            }
+            return area(x0, y0, x1 - x0, y1 - y0);
+        }
+
+
+        /**
+         * @brief       Check if a rectangle lies entirely within the set.
+         *
+         * @param[in]   r  The rectangle.
+         */
+        bool contains(const Rect& r) const {
+            return count(r) == r.width * r.height;
+        }
+
+
+        /**
+         * @brief       Check if the digital straight segment joining two
+         *              pixels lies entirely within the set.
+         *
+         * @details     The segment is rejected if any end point is outside
+         *              of the set. Otherwise it is bisected along its major
+         *              axis: a piece is accepted if its bounding rectangle
+         *              is inside of the set and rejected if it is outside,
+         *              both in constant time. Short pieces left undecided
+         *              are walked as a Bresenham line, one run of pixels
+         *              along the major axis at a time, and each run is
+         *              checked against the packed rows (or columns) a whole
+         *              word at a time.
+         *
+         * @param[in]   p1  A constant reference to the first pixel.
+         *
+         * @param[in]   p2  A constant reference to the second pixel.
+         *
+         * @return      True if every pixel of the segment belongs to the
+         *              set, false otherwise.
+         */
+        bool visible(const Point& p1, const Point& p2) const {
+            if (not contains(p1) or not contains(p2)) {
+                return false;
+            }
+            const Point a = p1 - _origin, b = p2 - _origin;
+            const int dx = b.x - a.x, dy = b.y - a.y;
+            Segment s;
+            s.transposed = std::abs(dx) < std::abs(dy);
+            // Walk along the major axis, from its lower end.
+            const bool swap = s.transposed ? dy < 0 : dx < 0;
+            const Point& from = swap ? b : a;
+            const Point& to = swap ? a : b;
+            s.u0 = s.transposed ? from.y : from.x;
+            s.v0 = s.transposed ? from.x : from.y;
+            s.du = s.transposed ? to.y - from.y : to.x - from.x;
+            const int dv = s.transposed ? to.x - from.x : to.y - from.y;
+            s.adv = std::abs(dv);
+            s.sv = (dv >= 0) ? 1 : -1;
+            return visible(s, 0, s.du);
+        }
+
+
+    private:
+
+        /**
+         * @brief       A digital straight segment, as a major axis `u` and
+         *              a minor axis `v`, in mask window coordinates.
+         *
+         * @details     The pixel at `u0 + t`, for `t` in `[0, du]`, is on
+         *              line `v0 + sv round(t adv / du)` (half up), so the
+         *              `k`-th run starts at `t = ceil((2 k - 1) du / (2
+         *              adv))`.
+         */
+        struct Segment {
+
+            int u0, v0; /**< First pixel. */
+
+            int du, adv, sv; /**< Major and minor axis displacements. */
+
+            bool transposed; /**< Major axis is `y`. */
+
+            int offset(const int t) const {
+                return (du == 0) ? 0 : (2 * t * adv + du) / (2 * du);
+            }
+
+            int start(const int k) const {
+                return (k == 0) ? 0 : ((2 * k - 1) * du + 2 * adv - 1) / (2 * adv);
+            }
+
+        };
+
+
+        /**
+         * @brief       Check if the pixels `[ta, tb]` of a segment lie
+         *              within the set.
+         */
+        bool visible(const Segment& s, const int ta, const int tb) const {
+            const int ka = s.offset(ta), kb = s.offset(tb);
+            const int va = s.v0 + s.sv * ka, vb = s.v0 + s.sv * kb;
+            const int u = s.u0 + ta, v = std::min(va, vb);
+            const int lu = tb - ta + 1, lv = kb - ka + 1;
+            const int inside = s.transposed ? area(v, u, lv, lu) : area(u, v, lu, lv);
+            if (inside == lu * lv) {
+                return true;
+            }
+            if (inside == 0) {
+                return false;
+            }
+            if (lu > 64) {
+                const int tm = ta + (tb - ta) / 2;
+                return visible(s, ta, tm) and visible(s, tm + 1, tb);
+            }
+            const std::vector< word_t >& bits = s.transposed ? _cols : _rows;
+            const int stride = s.transposed ? _colWords : _rowWords;
+            for (int k = ka; k <= kb; ++k) {
+                const int from = std::max(ta, s.start(k));
+                const int to = (k == kb) ? tb : s.start(k + 1) - 1;
+                if (not run(&bits[(s.v0 + s.sv * k) * stride], s.u0 + from, s.u0 + to)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+
+        /**
+         * @brief       Counts the pixels of a rectangle, in mask window
+         *              coordinates and within the window, belonging to the
+         *              set.
+         */
+        int area(const int x, const int y, const int w, const int h) const {
+            return _sum(y + h, x + w) - _sum(y, x + w) - _sum(y + h, x) + _sum(y, x);
+        }
+
+
+        /**
+         * @brief       Check if the bits `[from, to]` of a packed line are
+         *              all set.
+         */
+        static bool run(const word_t* line, const int from, const int to) {
+            const int fw = from >> 6, tw = to >> 6;
+            const word_t fm = ~(word_t) 0 << (from & 63);
+            const word_t tm = ~(word_t) 0 >> (63 - (to & 63));
+            if (fw == tw) {
+                return (line[fw] & fm & tm) == (fm & tm);
+            }
+            if ((line[fw] & fm) != fm) {
+                return false;
+            }
+            for (int w = fw + 1; w < tw; ++w) {
+                if (line[w] != ~(word_t) 0) {
+                    return false;
+                }
+            }
+            return (line[tw] & tm) == tm;
+        }
+
+
+    private:
+
+        Point _origin; /**< Position of the top left pixel of the mask. */
+
+        int _width, _height; /**< Size of the mask window. */
+
+        int _rowWords, _colWords; /**< Words per packed row and column. */
+
+        std::vector< word_t > _rows; /**< Mask packed row by row. */
+
+        std::vector< word_t > _cols; /**< Mask packed column by column. */
+
+        Mat_< int > _sum; /**< Integral image of the mask. */
+
+    };
+
+
+} // namespace cvx
+
+
+#endif // CVX_GEOMETRY_PLANAR_SET_HPP__INCLUDED
@@ -58,13 +58,10 @@ namespace cvx {
 
 
         /**
-         * @brief       Copy constructor.
-         * @param[in]   src A constant reference to a source object.
+         * @brief       Copy constructor, deleted: signatures are move-only,
+         *              use `clone()` or `view()` instead.
          */
-        Signature_(const Signature_& src) :
-        base_type(src) {
-            // NOOP
-        }
+        Signature_(const Signature_& src) = delete;
 
 
         /**
@@ -77,6 +74,17 @@ namespace cvx {
         }
 
 
+        /**
+         * @brief           Descriptor constructor, wraps an owning
+         *                  descriptor or a view.
+         * @param[in,out]   tmp A rvalue reference to a source object.
+         */
+        Signature_(base_type&& tmp) :
+        base_type(std::move(tmp)) {
+            // NOOP
+        }
+
+
         /**
          * @brief       Clone constructor.
          * @param[in]   src A constant reference to a compatible source object.
@@ -115,6 +123,43 @@ namespace cvx {
             // NOOP
         }
 
+
+        /**
+         * @brief           Move assignment operator.
+         * @param[in,out]   tmp A rvalue reference to a source object.
+         */
+        Signature_& operator=(Signature_&& tmp) {
+            return (base_type::assign(std::move(tmp)), *this);
+        }
+
+
+        /**
+         * @brief       Creates a non-owning view of contiguous features.
+         *
+         * @param[in]   data  Pointer to the first feature.
+         *
+         * @param[in]   size  Number of features.
+         */
+        static Signature_ view(const Real* data, const size_t size) {
+            return Signature_(base_type::view(data, size));
+        }
+
+
+        /**
+         * @brief   Returns a non-owning view of this signature.
+         */
+        Signature_ view() const {
+            return Signature_(base_type::view());
+        }
+
+
+        /**
+         * @brief   Returns an owning deep copy of this signature.
+         */
+        Signature_ clone() const {
+            return Signature_(base_type::clone());
+        }
+
     };
 
 
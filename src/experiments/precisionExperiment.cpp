@@ -0,0 +1,28 @@
+
+
+#include "precisionExperiment.hpp"
+
+/**
+ * precisionExperiment <dataset directory> <output file> [reference file]
+ *
+ * Writes the retrieval results of the dataset computed with real_t, and compares them with the reference file when
+ * one is given. Run the double build first and pass its output as the reference of the float build.
+ */
+int main(int argc, char** argv) {
+
+    if(argc < 3) {
+        std::cout << "usage: " << argv[0] << " <dataset directory> <output file> [reference file]" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Precision: " << (sizeof(real_t) == sizeof(float) ? "float" : "double") << std::endl;
+
+    std::vector<std::string> imageClassesDirectories = getClassDirectories(argv[1]);
+    writeRetrievalResults(imageClassesDirectories, argv[2]);
+
+    if(argc > 3) {
+        compareRetrievalResults(argv[3], argv[2]);
+    }
+
+    return 0;
+}
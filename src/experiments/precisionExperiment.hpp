@@ -0,0 +1,133 @@
+#ifndef CPSWITHSPLINES_PRECISIONEXPERIMENT_H
+#define CPSWITHSPLINES_PRECISIONEXPERIMENT_H
+
+#include "../main/main.hpp"
+#include "../main/filesManagementFunctions.hpp"
+#include "../main/cpsFunctions.hpp"
+#include "../main/contourUtilities.hpp"
+
+typedef struct retrievalResult {
+    std::string query_class;
+    int query_image;
+    std::string nearest_class;
+    int nearest_image;
+    double distance;
+} retrievalResult;
+
+void writeRetrievalResults(std::vector<std::string> imageClassesDirectories, std::string outputPath, int sampleSize = 64);
+std::vector<retrievalResult> readRetrievalResults(std::string path);
+void compareRetrievalResults(std::string referencePath, std::string currentPath);
+
+
+/**
+ * Retrieval over all the images of the dataset: every image is the query once, and its nearest image (lowest point
+ * matching cost) among all the others is written to outputPath, one query per line. The signatures and the matching
+ * use real_t, so running this from a double and a float build gives two files comparable with compareRetrievalResults.
+ */
+void writeRetrievalResults(std::vector<std::string> imageClassesDirectories, std::string outputPath, int sampleSize) {
+    std::vector<std::string> classes;
+    std::vector<int> images;
+    std::vector<cspResult> signatures;
+
+    for(int i = 0; i < imageClassesDirectories.size(); i++) {
+        std::string className = getClassNameFromPath(imageClassesDirectories[i]);
+        std::vector<cv::Mat> classImages = readImagesFromDirectory(imageClassesDirectories[i]);
+
+        std::cout << "Started processing class [ " << i << " ]: " << className << std::endl;
+        for(int j = 0; j < classImages.size(); j++) {
+            std::vector<cv::Point> fullContour = getKuimContour(classImages[j], ONLY_EXTERNAL_CONTOUR);
+            const double area = sqrt(contourArea(fullContour));
+            classes.push_back(className);
+            images.push_back(j);
+            signatures.push_back(computeCps(sampleContourPoints(fullContour, sampleSize), area));
+        }
+    }
+
+    std::fstream outputFile;
+    outputFile.open(outputPath.c_str(), std::ios_base::out);
+    outputFile << "QUERY_CLASS\tQUERY_IMAGE\tNEAREST_CLASS\tNEAREST_IMAGE\tDISTANCE" << std::endl;
+    outputFile.precision(17);
+
+    CpsMatcher matcher(sampleSize);
+    for(int q = 0; q < signatures.size(); q++) {
+        int nearest = -1;
+        double nearestDistance = 0;
+        for(int c = 0; c < signatures.size(); c++) {
+            if(c == q) {
+                continue;
+            }
+            /* only the signatures closer than the nearest one so far matter*/
+            double threshold = nearest < 0 ? std::numeric_limits<double>::infinity() : nearestDistance;
+            cpsMatch match = matcher.matchEarlyAbandon(signatures[q].CPSMatrix, signatures[c].CPSMatrix, threshold);
+            if(match.rotationIndex >= 0) {
+                nearest = c;
+                nearestDistance = match.cost;
+            }
+        }
+        if(nearest >= 0) {
+            outputFile << classes[q] << "\t" << images[q] << "\t" << classes[nearest] << "\t" << images[nearest]
+                       << "\t" << nearestDistance << std::endl;
+        }
+    }
+
+    outputFile.close();
+}
+
+std::vector<retrievalResult> readRetrievalResults(std::string path) {
+    std::vector<retrievalResult> results;
+    std::ifstream inputFile(path.c_str());
+    std::string line;
+
+    /* skip the header*/
+    std::getline(inputFile, line);
+    while(std::getline(inputFile, line)) {
+        std::stringstream ss(line);
+        retrievalResult result;
+        std::getline(ss, result.query_class, '\t');
+        ss >> result.query_image;
+        ss.ignore();
+        std::getline(ss, result.nearest_class, '\t');
+        ss >> result.nearest_image >> result.distance;
+        results.push_back(result);
+    }
+
+    return results;
+}
+
+/**
+ * Compare two retrieval result files of the same dataset (e.g. a double and a float run): report the hit rate of each
+ * one (the nearest image is of the query class), how many queries got a different nearest image, and the largest
+ * relative difference of the nearest distance over the queries that kept the same one.
+ */
+void compareRetrievalResults(std::string referencePath, std::string currentPath) {
+    std::vector<retrievalResult> reference = readRetrievalResults(referencePath);
+    std::vector<retrievalResult> current = readRetrievalResults(currentPath);
+
+    if(reference.size() != current.size()) {
+        std::cout << "The result files have a different number of queries: " << reference.size() << " and "
+                  << current.size() << std::endl;
+        return;
+    }
+
+    int referenceHits = 0, currentHits = 0, changed = 0;
+    double maxDifference = 0;
+    for(int i = 0; i < reference.size(); i++) {
+        referenceHits += reference[i].query_class == reference[i].nearest_class;
+        currentHits += current[i].query_class == current[i].nearest_class;
+        if(reference[i].nearest_class != current[i].nearest_class || reference[i].nearest_image != current[i].nearest_image) {
+            changed++;
+            std::cout << "Query " << reference[i].query_class << " " << reference[i].query_image << ": nearest was "
+                      << reference[i].nearest_class << " " << reference[i].nearest_image << ", now "
+                      << current[i].nearest_class << " " << current[i].nearest_image << std::endl;
+        } else if(reference[i].distance > 0) {
+            maxDifference = std::max(maxDifference, std::abs(current[i].distance - reference[i].distance) / reference[i].distance);
+        }
+    }
+
+    std::cout << "QUERIES\tREFERENCE_HITS\tCURRENT_HITS\tCHANGED_NEAREST\tMAX_RELATIVE_DIFFERENCE" << std::endl;
+    std::cout << reference.size() << "\t" << referenceHits << "\t" << currentHits << "\t" << changed << "\t"
+              << maxDifference << std::endl;
+}
+
+
+#endif //CPSWITHSPLINES_PRECISIONEXPERIMENT_H
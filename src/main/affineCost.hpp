@@ -0,0 +1,93 @@
+#ifndef CPSWITHSPLINES_AFFINECOST_H
+#define CPSWITHSPLINES_AFFINECOST_H
+
+#include "main.hpp"
+
+/**
+ * Affine transformation cost of a reference shape A against any rotation of another shape B: the sum of the absolute
+ * residuals of the least squares affine fit of the points of B, taken from the rotation index on, to the points of A.
+ * With P the N x 3 matrix of the points of A, rows (1, x, y), and Q the same for the rotated B, the fit is
+ * M = (P^T P)^-1 P^T Q and the residual P M - Q. The inverse of the 3 x 3 normal matrix P^T P depends on A only, so it
+ * is computed once, in the constructor; each rotation then takes the 3 x 3 sums P^T Q and a pass over the residuals,
+ * O(N) with fixed size matrices and no allocation. The points of A are centered on their centroid, which spans the same
+ * columns and keeps the normal matrix well conditioned for large coordinates.
+ */
+class AffineCost {
+public:
+    explicit AffineCost(const std::vector<cv::Point>& refA);
+
+    int size() const { return (int)xs.size(); }
+
+    double cost(const std::vector<cv::Point>& refB, int rotationIndex) const;
+    void costs(const std::vector<cv::Point>& refB, std::vector<double>& result) const;
+
+private:
+    std::vector<double> xs, ys;
+    Matrix3d inverseNormal;
+};
+
+
+AffineCost::AffineCost(const std::vector<cv::Point>& refA) : xs(refA.size()), ys(refA.size()) {
+    int n = refA.size();
+    double cx = 0, cy = 0;
+    for(int i = 0; i < n; i++) {
+        cx += refA[i].x;
+        cy += refA[i].y;
+    }
+    cx /= std::max(n, 1);
+    cy /= std::max(n, 1);
+
+    Matrix3d normal = Matrix3d::Zero();
+    for(int i = 0; i < n; i++) {
+        xs[i] = refA[i].x - cx;
+        ys[i] = refA[i].y - cy;
+        Vector3d p(1, xs[i], ys[i]);
+        normal += p * p.transpose();
+    }
+    /* a full rank inverse for shapes with three or more points not on a line; the pseudo-inverse otherwise*/
+    JacobiSVD<Matrix3d> svd(normal, ComputeFullU | ComputeFullV);
+    double tolerance = std::numeric_limits<double>::epsilon() * 3 * svd.singularValues()(0);
+    Vector3d inverseValues;
+    for(int k = 0; k < 3; k++) {
+        double value = svd.singularValues()(k);
+        inverseValues(k) = value > tolerance ? 1 / value : 0;
+    }
+    inverseNormal = svd.matrixV() * inverseValues.asDiagonal() * svd.matrixU().transpose();
+}
+
+/**
+ * Cost of the points of B from rotationIndex on: point i of A is paired with point (i + rotationIndex) % N of B.
+ */
+double AffineCost::cost(const std::vector<cv::Point>& refB, int rotationIndex) const {
+    int n = size();
+    Matrix3d cross = Matrix3d::Zero();
+    for(int i = 0; i < n; i++) {
+        int j = (i + rotationIndex) % n;
+        Vector3d p(1, xs[i], ys[i]);
+        Vector3d q(1, refB[j].x, refB[j].y);
+        cross += p * q.transpose();
+    }
+    Matrix3d M = inverseNormal * cross;
+
+    double sum = 0.0;
+    for(int i = 0; i < n; i++) {
+        int j = (i + rotationIndex) % n;
+        RowVector3d r = RowVector3d(1, xs[i], ys[i]) * M - RowVector3d(1, refB[j].x, refB[j].y);
+        sum += r.cwiseAbs().sum();
+    }
+    return sum;
+}
+
+/**
+ * Cost of every rotation of B, in result[rotationIndex]: O(N^2) in total.
+ */
+void AffineCost::costs(const std::vector<cv::Point>& refB, std::vector<double>& result) const {
+    int n = size();
+    result.resize(n);
+    for(int k = 0; k < n; k++) {
+        result[k] = cost(refB, k);
+    }
+}
+
+
+#endif //CPSWITHSPLINES_AFFINECOST_H
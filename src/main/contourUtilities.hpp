@@ -116,32 +116,41 @@ std::vector<cv::Point> sampleContourPoints(std::vector<cv::Point> fullContour, i
     return sampledPoints;
 }
 
+/**
+ * Sample sampleSize points evenly spaced along the spline. Each segment is evaluated at t = 0, 0.0001, ... 1 and its
+ * length is the length of that polyline; the evaluation and the chord lengths run the cubic and chords kernels (see
+ * cvx::kernels).
+ */
 std::vector<cv::Point> samplePointsFromSpline(MatrixXd resultsMatrixX, MatrixXd resultsMatrixY, int sampleSize) {
 
-    double perimeter = 0;
-    for (int f = 0; f < resultsMatrixX.rows(); f++) {
-        //eq coefficients
-        double ax = resultsMatrixX(f,0);
-        double bx = resultsMatrixX(f,1);
-        double cx = resultsMatrixX(f,2);
-        double dx = resultsMatrixX(f,3);
+    const cvx::Kernels_<double>& kernels = cvx::kernels<double>();
 
-        double ay = resultsMatrixY(f,0);
-        double by = resultsMatrixY(f,1);
-        double cy = resultsMatrixY(f,2);
-        double dy = resultsMatrixY(f,3);
-
-        double lastX = dx;
-        double lastY = dy;
-
-        for(double t = 0.0001; t <= 1; t += 0.0001){
-            double thisX = (ax * pow(t,3)) + (bx * pow(t,2)) + (cx * t) + dx;
-            double thisY = (ay * pow(t,3)) + (by * pow(t,2)) + (cy * t) + dy;
+    /* parameter values of a segment, the first one is its starting point*/
+    std::vector<double> ts(1, 0.0);
+    for(double t = 0.0001; t <= 1; t += 0.0001){
+        ts.push_back(t);
+    }
+    int steps = ts.size();
+    int segments = resultsMatrixX.rows();
 
-            perimeter += sqrt( pow((thisX - lastX),2) + pow((thisY - lastY),2));
+    /* points of segment f and the lengths of its chords*/
+    std::vector<double> xs(steps), ys(steps), lengths(steps - 1);
+    auto evaluateSegment = [&](int f) {
+        //eq coefficients
+        double cx[4] = {resultsMatrixX(f,0), resultsMatrixX(f,1), resultsMatrixX(f,2), resultsMatrixX(f,3)};
+        double cy[4] = {resultsMatrixY(f,0), resultsMatrixY(f,1), resultsMatrixY(f,2), resultsMatrixY(f,3)};
+        kernels.cubic(cx, cy, &ts[0], &xs[0], &ys[0], steps);
+        /* the starting point is exactly the independent term*/
+        xs[0] = cx[3];
+        ys[0] = cy[3];
+        kernels.chords(&xs[0], &ys[0], &lengths[0], steps);
+    };
 
-            lastX = thisX;
-            lastY = thisY;
+    double perimeter = 0;
+    for (int f = 0; f < segments; f++) {
+        evaluateSegment(f);
+        for (int k = 0; k < steps - 1; k++) {
+            perimeter += lengths[k];
         }
     }
 
@@ -149,43 +158,25 @@ std::vector<cv::Point> samplePointsFromSpline(MatrixXd resultsMatrixX, MatrixXd
     std::vector<cv::Point> sampledPoints;
 
     double currentSpacing = 0;
-    for (int f = 0; f < resultsMatrixX.rows(); f++) {
-        //eq coefficients
-        double ax = resultsMatrixX(f, 0);
-        double bx = resultsMatrixX(f, 1);
-        double cx = resultsMatrixX(f, 2);
-        double dx = resultsMatrixX(f, 3);
-
-        double ay = resultsMatrixY(f, 0);
-        double by = resultsMatrixY(f, 1);
-        double cy = resultsMatrixY(f, 2);
-        double dy = resultsMatrixY(f, 3);
-
-        double lastX = dx;
-        double lastY = dy;
+    for (int f = 0; f < segments && (int)sampledPoints.size() < sampleSize; f++) {
+        evaluateSegment(f);
 
         if (sampledPoints.size() == 0) {
-            sampledPoints.push_back(cvPoint((int) round(dx), (int) round(dy)));
+            sampledPoints.push_back(cvPoint((int) round(xs[0]), (int) round(ys[0])));
         }
 
-        for (double t = 0.0001; t <= 1; t += 0.0001) {
-            double thisX = (ax * pow(t, 3)) + (bx * pow(t, 2)) + (cx * t) + dx;
-            double thisY = (ay * pow(t, 3)) + (by * pow(t, 2)) + (cy * t) + dy;
-
-            currentSpacing += sqrt(pow((thisX - lastX), 2) + pow((thisY - lastY), 2));
+        for (int k = 1; k < steps; k++) {
+            currentSpacing += lengths[k - 1];
 
             if (currentSpacing >= spacingNeeded) {
                 currentSpacing = 0;
-                sampledPoints.push_back(cvPoint((int) round(thisX), (int) round(thisY)));
+                sampledPoints.push_back(cvPoint((int) round(xs[k]), (int) round(ys[k])));
 
                 if (sampledPoints.size() == sampleSize) {
                     //when the sample has the desired size, break the loops
-                    t = 1.1;
-                    f = resultsMatrixX.rows();
+                    break;
                 }
             }
-            lastX = thisX;
-            lastY = thisY;
         }
     }
 
@@ -9,9 +9,13 @@
 #include "main.hpp"
 #include "contourUtilities.hpp"
 #include "generalFunctions.hpp"
+#include "cpsRows.hpp"
+#include "fixedCps.hpp"
+#include "cpsMatcher.hpp"
+#include "affineCost.hpp"
 
 typedef struct {
-    MatrixXd CPSMatrix;
+    CpsRows CPSMatrix;
     std::vector<cv::Point> pointSample;
 } cspResult;
 
@@ -19,13 +23,23 @@ typedef struct {
 cspResult generateCpsWithSplineRefinement(std::vector<cv::Point> X, const double area);
 /*Functions implementation*/
 cspResult computeCps(std::vector<cv::Point> contourPoints, const double area);
+template<typename DistanceFunction>
+cspResult computeCps(const std::vector<cv::Point>& contourPoints, const double area, const DistanceFunction& distance);
+template<typename DistanceFunction>
+void computeCpsRow(const DistanceFunction& distance, const real_t* xs, const real_t* ys, int n, int i, real_t normalization, real_t* row);
+void computeCpsRow(const cvx::DistanceL2& distance, const real_t* xs, const real_t* ys, int n, int i, real_t normalization, real_t* row);
 //only for debug
-std::vector<double> smCpsRm(MatrixXd mta, MatrixXd mtb);
-cv::Point2d matchingCps(cvx::CpsMatrix cpsA, cvx::CpsMatrix cpsB);
+std::vector<double> smCpsRm(MatrixXr mta, MatrixXr mtb);
+cv::Point2d matchingCps(const cvx::CpsMatrix& cpsA, const cvx::CpsMatrix& cpsB);
 double getAfinTansformationCost(std::vector<cv::Point> refA, std::vector<cv::Point> refB, int rotationIndex );
-double similarityMeasure (cspResult A, cspResult B, double alpha, double beta);
-std::vector<double> getPointMatchingCost(MatrixXd mta, MatrixXd mtb);
-double r_measure (std::vector<double> X,std::vector<double> Y) ;
+double similarityMeasure (const cspResult& A, const cspResult& B, double alpha, double beta);
+double similarityMeasure (const cspResult& A, const AffineCost& affineA, const cspResult& B, double alpha, double beta);
+double similarityMeasure (const cspResult& A, const AffineCost& affineA, const cspResult& B, double alpha, double beta,
+                          double threshold, CpsMatcher& matcher);
+std::vector<double> getPointMatchingCost(const CpsRows& mta, const CpsRows& mtb);
+real_t r_measure (const std::vector<real_t>& X, const std::vector<real_t>& Y) ;
+real_t r_measure (const real_t* X, const real_t* invX, const real_t* Y, const real_t* invY, int n);
+real_t r_measure (const real_t* X, const real_t* Y, int n);
 
 
 /**
@@ -133,178 +147,169 @@ cspResult generateCpsWithSplineRefinement(std::vector<cv::Point> vector, const d
 
 
 /**
- * Create the cps signature for a specific contour.
+ * Create the cps signature for a specific contour, using the euclidean distance.
  */
 cspResult computeCps(std::vector<cv::Point> contourPoints, const double area) {
+    return computeCps(contourPoints, area, cvx::DistanceEuclidean());
+}
+
+/**
+ * Create the cps signature for a specific contour, using any of the cvx distance functors (cvx::DistanceL1,
+ * cvx::DistanceL2, cvx::DistanceLinf, cvx::Distance_<cvx::NormLp_<P>>, ...). The functor type is a template
+ * parameter, so its norm is inlined into the loop. The common sample counts go to the fixed-size kernels. The
+ * reciprocals of the signature are stored with it.
+ */
+template<typename DistanceFunction>
+cspResult computeCps(const std::vector<cv::Point>& contourPoints, const double area, const DistanceFunction& distance) {
     cspResult R;
-    MatrixXd cps(contourPoints.size(),contourPoints.size());
-    MatrixXd aux(contourPoints.size(),contourPoints.size());
-    /*"initialize with "0"*/
-    for(int i=0 ; i < contourPoints.size() ; i++ ){
-        for(int j=0 ; j < contourPoints.size() ; j++ ){
-            aux(i,j) = 0;
-        }
+    int n = contourPoints.size();
+    R.pointSample = contourPoints;
+    if(computeCpsFixed(contourPoints, (real_t)(1 / sqrt(area)), distance, R.CPSMatrix)) {
+        R.CPSMatrix.computeReciprocals();
+        return R;
     }
-    /* Calculate the distance between points */
-    for(int i=0 ; i < contourPoints.size() ; i++ ){
-        for(int j=0 ; j < contourPoints.size() ; j++ ){
-            if(i<j){
-                aux(i,j) = sqrt((contourPoints[i].x - contourPoints[j].x)*(contourPoints[i].x - contourPoints[j].x) + (contourPoints[i].y - contourPoints[j].y)*(contourPoints[i].y - contourPoints[j].y));
-                if(aux(i,j)==0){
-                    aux(i,j) = 1;
-                }
-            } else if(i>j){
-                aux(i,j) = aux(j,i);
-            }
-        }
+
+    /* Coordinates as a structure of arrays, for the batch distance members*/
+    std::vector<real_t> xs(n), ys(n);
+    for(int i = 0; i < n; i++) {
+        xs[i] = contourPoints[i].x;
+        ys[i] = contourPoints[i].y;
     }
-    /* we need to rotate the rows i-1 places to the left  and we normalize the values*/
-    for(int i=0 ; i < contourPoints.size() ; i++ ){
-        for(int j=0 ; j < contourPoints.size() ; j++ ){
-            if(j+1+i>= contourPoints.size()){
-                cps(i,j) = aux(i,j+1+i - contourPoints.size())/sqrt(area);
-            }else{
-                cps(i,j) = aux(i,j+1+i)/sqrt(area);
-            }
-        }
+
+    R.CPSMatrix.resize(n, n);
+    for(int i = 0; i < n; i++) {
+        computeCpsRow(distance, &xs[0], &ys[0], n, i, (real_t)(1 / sqrt(area)), R.CPSMatrix.row(i));
     }
+    /* the matching step reads the reciprocals of every row*/
+    R.CPSMatrix.computeReciprocals();
 
-    R.CPSMatrix = cps;
-    R.pointSample = contourPoints;
     return R;
 
 }
 
-double similarityMeasure (cspResult A, cspResult B, double alpha, double beta) {
+/**
+ * Row i of the cps signature of the n points (xs, ys): the distances from point i to the points i+1, i+2, ...
+ * (the distance matrix rows rotated i+1 places to the left), normalized. The two contiguous runs of points are
+ * handed to the batch member of the distance functor. Coincident points are considered at distance 1, and the
+ * distance of the point to itself goes to the last column.
+ */
+template<typename DistanceFunction>
+void computeCpsRow(const DistanceFunction& distance, const real_t* xs, const real_t* ys, int n, int i, real_t normalization, real_t* row) {
+    cvx::Point2r p(xs[i], ys[i]);
+    distance.batch(p, xs + i + 1, ys + i + 1, row, n - 1 - i);
+    distance.batch(p, xs, ys, row + n - 1 - i, i);
+    for(int j = 0; j < n - 1; j++) {
+        row[j] = (row[j] == 0 ? 1 : row[j]) * normalization;
+    }
+    row[n - 1] = 0;
+}
+
+/**
+ * Same as computeCpsRow for the euclidean distance, with the cps_run kernel (see cvx::kernels).
+ */
+void computeCpsRow(const cvx::DistanceL2&, const real_t* xs, const real_t* ys, int n, int i, real_t normalization, real_t* row) {
+    const cvx::Kernels_<real_t>& kernels = cvx::kernels<real_t>();
+    kernels.cps_run(xs[i], ys[i], xs + i + 1, ys + i + 1, row, n - 1 - i, normalization);
+    kernels.cps_run(xs[i], ys[i], xs, ys, row + n - 1 - i, i, normalization);
+    row[n - 1] = 0;
+}
+
+double similarityMeasure (const cspResult& A, const cspResult& B, double alpha, double beta) {
+
+    return similarityMeasure(A, AffineCost(A.pointSample), B, alpha, beta);
+
+}
+
+/**
+ * Same as similarityMeasure(A, B, alpha, beta), with the affine cost engine of A already built, for comparing A
+ * against many shapes (see AffineCost).
+ */
+double similarityMeasure (const cspResult& A, const AffineCost& affineA, const cspResult& B, double alpha, double beta) {
 
     std::vector<double> pointMatchingCostResult = getPointMatchingCost(A.CPSMatrix, B.CPSMatrix);
 
     double rotationIx = pointMatchingCostResult[0];
     double pointMatchingCost = pointMatchingCostResult[1];
 
-    double afinTransformationCost = getAfinTansformationCost(A.pointSample, B.pointSample, (int)rotationIx);
+    double afinTransformationCost = affineA.cost(B.pointSample, (int)rotationIx);
 
     return alpha*pointMatchingCost + beta*afinTransformationCost;
 
 }
 
 /**
- * This method get the distance between two cps matrix.
+ * Same as similarityMeasure(A, affineA, B, alpha, beta) when the measure is below threshold, for classification, where
+ * only the shapes under a decision threshold or the current best matter; otherwise the result is infinity. The affine
+ * cost is not negative, so for non negative weights the point matching cost alone must be below threshold / alpha:
+ * that bound goes to the rotation search (see CpsMatcher::matchEarlyAbandon), which gives up on rotations as soon as
+ * they exceed it, and the affine cost is only computed for a rotation under it.
  */
-std::vector<double> getPointMatchingCost(MatrixXd mta, MatrixXd mtb) {
-    std::vector<double> result;
-    /* Number of point samples*/
-    double n = mta.rows();
-    MatrixXd matrix((int)n,(int)n);
-
-    /*Each value of k represent a different rotation*/
-    for(int k = 0; k <  n; k++) {
-
-        std::vector<int> vector;
-        for (double u = k - 1; u < n-1 + k; u++) {
-            if(u >= n-1)
-                vector.push_back((int)fmod( u , n-1));
-            else
-                vector.push_back((int)fmod( u , n-1)+1);
-
-        }
-
-        /*Calculate the euclidian distance*/
-        for(int i = 0; i <  n; i++) {
-            double sumDist = 0;
-            std::vector<double> X;
-            std::vector<double> Y;
-            for(int j = 0; j < n; j++) {
-                X.push_back(mta(i,j));
-                Y.push_back(mtb(vector[i],j));
-            }
-            matrix(i,k) = r_measure(X,Y);
-        }
-    }
-    /*the X(METRIC 1) coordinate is the minim sum and the Y coordinate is the index of that column on the matrix cpsA*/
-    cv::Point2d matchingData = minSum(matrix);
-    result.push_back(matchingData.y);
-    double maxValue = matrix(0,matchingData.y);
-    for(int i = 0; i <  n; i++) {
-        if(matrix(i,matchingData.y)>maxValue){
-            maxValue = matrix(i,matchingData.y);
-        }
-    }
-    //result.push_back(maxValue);
-    result.push_back((matchingData.x) ); // promedio
+double similarityMeasure (const cspResult& A, const AffineCost& affineA, const cspResult& B, double alpha, double beta,
+                          double threshold, CpsMatcher& matcher) {
 
-    return result;
-}
+    const double infinity = std::numeric_limits<double>::infinity();
+    bool bounded = alpha > 0 && beta >= 0;
 
+    cpsMatch match = matcher.matchEarlyAbandon(A.CPSMatrix, B.CPSMatrix, bounded ? threshold / alpha : infinity);
+    if(match.rotationIndex < 0) {
+        return infinity;
+    }
 
-double getAfinTansformationCost(std::vector<cv::Point> refA, std::vector<cv::Point> refB, int rotationIndex ) {
+    double pointMatchingCost = alpha*match.cost;
+    if(bounded && pointMatchingCost >= threshold) {
+        return infinity;
+    }
 
-    MatrixXd P(refA.size(),3), Q(refA.size(),3);
-    int N = refA.size();
+    double measure = pointMatchingCost + beta*affineA.cost(B.pointSample, match.rotationIndex);
+    return measure < threshold ? measure : infinity;
 
-    for (int i = 0; i < N; i++) {
-        P(i,0) = 1;
-        P(i,1) = refA[i].x;
-        P(i,2) = refA[i].y;
+}
 
-        Q(i,0) = 1;
-        Q(i,1) = refB[(i + rotationIndex) % N].x;
-        Q(i,2) = refB[(i + rotationIndex) % N].y;
-    }
+/**
+ * This method get the distance between two cps matrix: the index of the best rotation and its cost. To match many
+ * pairs without allocating, use a CpsMatcher.
+ */
+std::vector<double> getPointMatchingCost(const CpsRows& mta, const CpsRows& mtb) {
+    CpsMatcher matcher;
+    cpsMatch match = matcher.match(mta, mtb);
 
-    MatrixXd pseudoInvertedP = pseudoInverse(P);
-    MatrixXd A = Q * pseudoInvertedP;
+    std::vector<double> result;
+    result.push_back(match.rotationIndex);
+    result.push_back(match.cost);
+    return result;
+}
 
-    MatrixXd R = (A*P - Q);
 
-    double sum = 0.0;
-    for (int i = 0; i < R.rows(); i++) {
-        for (int j = 0; j < R.cols(); j++) {
-            sum += R(i,j) > 0 ? R(i,j) : -1*R(i,j);
-        }
-    }
+/**
+ * The sum of the absolute residuals of the least squares affine fit of refB, from rotationIndex on, to refA. To score
+ * several rotations or shapes against the same refA, build its AffineCost once.
+ */
+double getAfinTansformationCost(std::vector<cv::Point> refA, std::vector<cv::Point> refB, int rotationIndex ) {
+
+    return AffineCost(refA).cost(refB, rotationIndex);
 
-    return sum;
 }
 
 
 /**
 * This method is going to make the matching step, using the euclidian distance.(is possible to use the r_measure distance measure).
+* The X coordinate is the minimum cost and the Y coordinate the index of the rotation (see CpsMatcher::matchL2).
 */
-cv::Point2d matchingCps(cvx::CpsMatrix cpsA, cvx::CpsMatrix cpsB){
-    /* Number of point samples*/
-    double n = cpsA.data().rows;
-    MatrixXd matrix;
-
-
-    /* Each value of k represent a different rotation*/
-    int vectorIndex = 0;
-    std::vector<double> vector;
-    for(int k = 0; k <  n; k++) {
-        for (double u = k - 1; u < n + k - 2; u++) {
-            vector[vectorIndex] = fmod( u , n)+1;
-            vectorIndex++;
-        }
-        /* Calculate the euclidian distance*/
-        for(int i = 0; i <  n; i++) {
-            double sumDist = 0;
-            for(int j = 0; j <  n; j++) {
-                sumDist += pow(cpsA.data()[i,j]-cpsB.data()[vector[i],j],2);
-            }
-            matrix(i,k) = sqrt(sumDist);
-        }
-        vectorIndex = 0;
-    }
-    /* the X(METRIC 1) coordenate is the minim sum and the Y cordenate is the index of that column on the matrix cpsA*/
-    cv::Point2d matchingData = minSum(matrix);
-    return matchingData;
+cv::Point2d matchingCps(const cvx::CpsMatrix& cpsA, const cvx::CpsMatrix& cpsB){
+    CpsMatcher matcher;
+    cpsMatch match = matcher.matchL2(cpsA, cpsB);
+    return cv::Point2d(match.cost, match.rotationIndex);
 }
 
-double r_measure (std::vector<double> X,std::vector<double> Y) {
+/**
+ * The r measure between two cps rows. The two sums are compensated (see CompensatedSum), so the measure keeps its
+ * accuracy over long rows when real_t is float.
+ */
+real_t r_measure (const std::vector<real_t>& X, const std::vector<real_t>& Y) {
     int b = X.size();
     int N = b - 1;
 
-    std::vector<double> c1, c2, dxsy, dysx;
+    std::vector<real_t> c1, c2, dxsy, dysx;
     c1.push_back(1);
     c2.push_back(1);
     for(int i = 0; i < N; i++){
@@ -319,16 +324,32 @@ double r_measure (std::vector<double> X,std::vector<double> Y) {
         dysx.push_back(c2[i+1] > c2[i] ? c2[i+1] - c2[i] : c2[i] - c2[i+1]);
     }
 
-    double sum1 = 0, sum2 = 0;
+    CompensatedSum sum1, sum2;
     for(int i = 1; i < N; i++){
-        sum1 += dxsy[i];
-        sum2 += dysx[i];
+        sum1.add(dxsy[i]);
+        sum2.add(dysx[i]);
     }
 
-    sum1 += 0.5 * (dxsy[0] + dxsy[N]);
-    sum2 += 0.5 * (dysx[0] + dysx[N]);
+    sum1.add((real_t)0.5 * (dxsy[0] + dxsy[N]));
+    sum2.add((real_t)0.5 * (dysx[0] + dysx[N]));
+
+    return sum1.sum * sum2.sum;
+}
 
-    return sum1 * sum2;
+/**
+ * Same measure as r_measure(X, Y), but reading the rows in place and using the precomputed reciprocals of both
+ * rows (invX[i] = 1/X[i]), so the ratios are computed with multiplications only and nothing is allocated. It runs the
+ * r_measure_inv kernel, the fixed-size one for the common sample counts (see rMeasureInvKernel).
+ */
+real_t r_measure (const real_t* X, const real_t* invX, const real_t* Y, const real_t* invY, int n) {
+    return rMeasureInvKernel(n)(X, invX, Y, invY, n);
+}
+
+/**
+ * Same measure as r_measure(X, Y), reading the rows in place, without allocating. It runs the r_measure kernel.
+ */
+real_t r_measure (const real_t* X, const real_t* Y, int n) {
+    return cvx::kernels<real_t>().r_measure(X, Y, n);
 }
 
 
@@ -0,0 +1,663 @@
+#ifndef CPSWITHSPLINES_CPSMATCHER_H
+#define CPSWITHSPLINES_CPSMATCHER_H
+
+#include "main.hpp"
+#include "generalFunctions.hpp"
+#include "cpsRows.hpp"
+#include "fixedCps.hpp"
+#include <algorithm>
+#include <limits>
+
+/**
+ * Result of matching two cps signatures: the rotation of the second one that matches the first one best, and its cost.
+ * When both orientations are matched, mirrored tells the rotation is of the mirrored second signature (see
+ * CpsRows::mirror).
+ */
+typedef struct {
+    int rotationIndex;
+    double cost;
+    bool mirrored;
+} cpsMatch;
+
+/**
+ * Zero-copy Eigen view of the rows of a cvx::CpsMatrix, whose rows may be padded (see cvx::CpsMatrix::allocate).
+ */
+typedef Eigen::Map<const RowMatrixXr, Eigen::Unaligned, OuterStride<> > CpsMatrixRows;
+
+CpsMatrixRows cpsMatrixRows(const cvx::CpsMatrix& cps);
+
+/**
+ * Parameters of CpsMatcher::matchCoarseToFine: every rowStep-th row scores all the rotations, the best candidates
+ * rotations and their neighbours on each side are measured with all the rows, and when exact is set the result is
+ * checked against every other rotation (with early abandon). rowStep and candidates must be positive, and neighbours
+ * not negative.
+ */
+struct CoarseToFineOptions {
+    int rowStep;
+    int candidates;
+    int neighbours;
+    bool exact;
+
+    CoarseToFineOptions() : rowStep(8), candidates(4), neighbours(1), exact(false) {}
+};
+
+/**
+ * Agreement of the coarse to fine search with the exhaustive one, over the matches run with the exact option: the
+ * number of them, and how many found the best rotation without the check.
+ */
+struct CoarseToFineStatistics {
+    long verified;
+    long agreed;
+
+    CoarseToFineStatistics() : verified(0), agreed(0) {}
+
+    double agreement() const { return verified > 0 ? (double)agreed / verified : 1; }
+};
+
+/**
+ * Parameters of CpsMatcher::matchElastic: the half width of the Sakoe-Chiba band, in rows, the row pair cost (the
+ * euclidean distance if l2 is set, the r measure otherwise), and the cost above which a match is of no interest.
+ * Rotations are skipped by a lower bound only with the euclidean distance.
+ */
+struct ElasticOptions {
+    int band;
+    bool l2;
+    double threshold;
+
+    ElasticOptions() : band(8), l2(false), threshold(std::numeric_limits<double>::infinity()) {}
+};
+
+/**
+ * Matching step of getPointMatchingCost as a reusable object. The cost of every rotation is accumulated in a workspace
+ * that is kept between calls, and the rows are read in place, so matching signatures of a size already seen does no
+ * heap allocation. The results are the same as getPointMatchingCost. When both signatures carry their reciprocals
+ * (see CpsRows::computeReciprocals), the r measure multiplies by them instead of dividing, with the kernel compiled
+ * for the size of the signatures when it is one of the common sample counts (see rMeasureInvKernel).
+ */
+class CpsMatcher {
+public:
+    CpsMatcher();
+    explicit CpsMatcher(int n);
+
+    void reserve(int n);
+
+    cpsMatch match(const CpsRows& mta, const CpsRows& mtb);
+    cpsMatch matchEarlyAbandon(const CpsRows& mta, const CpsRows& mtb,
+                               double threshold = std::numeric_limits<double>::infinity());
+    cpsMatch matchBothOrientations(const CpsRows& mta, const CpsRows& mtb,
+                                   double threshold = std::numeric_limits<double>::infinity());
+    cpsMatch matchBothOrientations(const CpsRows& mta, const CpsRows& mtb, const CpsRows& mirrorB,
+                                   double threshold = std::numeric_limits<double>::infinity());
+    cpsMatch matchCoarseToFine(const CpsRows& mta, const CpsRows& mtb,
+                               const CoarseToFineOptions& options = CoarseToFineOptions());
+    cpsMatch matchElastic(const CpsRows& mta, const CpsRows& mtb, const ElasticOptions& options = ElasticOptions());
+
+    const CoarseToFineStatistics& coarseToFineStatistics() const { return statistics; }
+    void resetCoarseToFineStatistics() { statistics = CoarseToFineStatistics(); }
+
+    cpsMatch match(const cvx::CpsMatrix& mta, const cvx::CpsMatrix& mtb);
+
+    cpsMatch matchL2(const CpsRows& mta, const CpsRows& mtb);
+    cpsMatch matchL2(const cvx::CpsMatrix& mta, const cvx::CpsMatrix& mtb);
+    template<typename MatrixA, typename MatrixB>
+    cpsMatch matchL2(const Eigen::MatrixBase<MatrixA>& mta, const Eigen::MatrixBase<MatrixB>& mtb);
+
+private:
+    void prepare(int n);
+    template<typename Measure>
+    cpsMatch accumulate(int n, const Measure& measure);
+    cpsMatch bestRotation(int n) const;
+    void orderRotations(const CpsRows& mta, const CpsRows& mtb, bool mirrored);
+    template<typename Measure>
+    cpsMatch abandon(int n, int count, double threshold, const Measure& measure);
+    template<typename Measure>
+    cpsMatch coarseToFine(int n, const CoarseToFineOptions& options, const Measure& measure);
+    template<typename Measure>
+    double warp(int n, int band, int rotation, double bound, const Measure& measure);
+
+    std::vector<CompensatedSum> costs;
+    MatrixXr products;
+    VectorXr normsA;
+    VectorXr normsB;
+    std::vector<real_t> estimates;
+    std::vector<int> order;
+    std::vector<char> measured;
+    CpsRows mirror;
+    MatrixXr pairCosts;
+    std::vector<double> previousRow;
+    std::vector<double> currentRow;
+    CoarseToFineStatistics statistics;
+};
+
+
+CpsMatrixRows cpsMatrixRows(const cvx::CpsMatrix& cps) {
+    const cvx::CpsMatrix::matrix_t& data = cps.data();
+    if(data.rows == 0) {
+        return CpsMatrixRows((const real_t*)0, 0, 0, OuterStride<>(1));
+    }
+    return CpsMatrixRows(data.ptr<real_t>(0), data.rows, data.cols, OuterStride<>(data.step / sizeof(real_t)));
+}
+
+
+CpsMatcher::CpsMatcher() {
+}
+
+CpsMatcher::CpsMatcher(int n) {
+    reserve(n);
+}
+
+/**
+ * Allocate the workspace for signatures of up to n points.
+ */
+void CpsMatcher::reserve(int n) {
+    costs.reserve(n);
+    products.resize(n, n);
+    normsA.resize(n);
+    normsB.resize(n);
+    estimates.reserve(n);
+    order.reserve(n);
+    measured.reserve(n);
+}
+
+/**
+ * Reset the rotation costs; this only allocates when n is larger than any size seen before.
+ */
+void CpsMatcher::prepare(int n) {
+    costs.assign(n, CompensatedSum());
+}
+
+/**
+ * The first rotation with the minimum cost, as minSum does.
+ */
+cpsMatch CpsMatcher::bestRotation(int n) const {
+    cpsMatch result;
+    result.rotationIndex = 0;
+    /* empty signatures: rotation 0, at no cost*/
+    result.cost = n > 0 ? costs[0].sum : 0;
+    result.mirrored = false;
+    for(int k = 1; k < n; k++) {
+        if(costs[k].sum < result.cost) {
+            result.rotationIndex = k;
+            result.cost = costs[k].sum;
+        }
+    }
+    return result;
+}
+
+/**
+ * Add measure(i, j), the r measure of row i of the first signature against row j of the second one, to the cost of
+ * rotation k = (j - i) mod n, and return the best rotation. Each row of the first signature is measured against every
+ * row of the second one while it is in cache; the cost of each rotation still adds its rows in order, so the sums are
+ * the same as adding the columns of the n x n cost matrix.
+ */
+template<typename Measure>
+cpsMatch CpsMatcher::accumulate(int n, const Measure& measure) {
+    prepare(n);
+    for(int i = 0; i < n; i++) {
+        /* k = j - i, without a modulo per row*/
+        for(int j = 0; j < n; j++) {
+            int k = (j >= i) ? j - i : j - i + n;
+            costs[k].add(measure(i, j));
+        }
+    }
+    return bestRotation(n);
+}
+
+/**
+ * Match two signatures of n points: rotation k pairs row i of mta with row (i+k)%n of mtb. Signatures with
+ * reciprocals use the r_measure_inv kernel, the others the r_measure kernel; both add the rows of a rotation in the
+ * same order, with the same compensated sums, so the two costs only differ by the rounding of x * (1/y) against x / y.
+ */
+cpsMatch CpsMatcher::match(const CpsRows& mta, const CpsRows& mtb) {
+    if(mta.hasReciprocals() && mtb.hasReciprocals()) {
+        const int n = mta.rows();
+        const RMeasureInv measureInv = rMeasureInvKernel(n);
+        return accumulate(n, [&](int i, int j) {
+            return measureInv(mta.row(i), mta.reciprocal(i), mtb.row(j), mtb.reciprocal(j), n);
+        });
+    }
+    const cvx::Kernels_<real_t>& kernels = cvx::kernels<real_t>();
+    const int n = mta.rows();
+    return accumulate(n, [&](int i, int j) {
+        return kernels.r_measure(mta.row(i), mtb.row(j), n);
+    });
+}
+
+/**
+ * Match two signature matrices of the cvx library (e.g. from cvx::CpSignature_::full_cps) of M rows of N values, read
+ * in place through Mat_::ptr: rotation k pairs row i of mta with row (i+k)%M of mtb. Unlike the rows of CpsRows, which
+ * end with the zero distance of each point to itself, all the N values of a row are distances, so the r measure
+ * kernel is given rows of N+1 values, of which it reads the first N.
+ */
+cpsMatch CpsMatcher::match(const cvx::CpsMatrix& mta, const cvx::CpsMatrix& mtb) {
+    CV_Assert(mta.sampling() == mtb.sampling() && mta.definition() == mtb.definition());
+    const cvx::CpsMatrix::matrix_t& a = mta.data();
+    const cvx::CpsMatrix::matrix_t& b = mtb.data();
+    const cvx::Kernels_<real_t>& kernels = cvx::kernels<real_t>();
+    const int n = mta.definition() + 1;
+    return accumulate(mta.sampling(), [&](int i, int j) {
+        return kernels.r_measure(a.ptr<real_t>(i), b.ptr<real_t>(j), n);
+    });
+}
+
+/**
+ * Visiting order of the rotations for matchEarlyAbandon, most promising first. The estimate of rotation k compares
+ * the row sums of both signatures (the total distance from each point to the others, which does not depend on the
+ * rotation): the sum over i of |sum of row i of mta - sum of row (i+k)%n of mtb|, O(n^2) in total. When mirrored is
+ * set, the rotations of the mirrored mtb follow as n ... 2n-1; its row m has the sum of row n-1-m of mtb.
+ */
+void CpsMatcher::orderRotations(const CpsRows& mta, const CpsRows& mtb, bool mirrored) {
+    const int n = mta.rows();
+    const int count = mirrored ? 2 * n : n;
+    /* the row sums go to the norm vectors of the workspace*/
+    normsA = mta.matrix().rowwise().sum();
+    normsB = mtb.matrix().rowwise().sum();
+    estimates.assign(count, 0);
+    for(int i = 0; i < n; i++) {
+        for(int j = 0; j < n; j++) {
+            int k = (j >= i) ? j - i : j - i + n;
+            estimates[k] += std::abs(normsA(i) - normsB(j));
+            if(mirrored) {
+                estimates[n + k] += std::abs(normsA(i) - normsB(n - 1 - j));
+            }
+        }
+    }
+    order.resize(count);
+    for(int k = 0; k < count; k++) {
+        order[k] = k;
+    }
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        return estimates[a] < estimates[b] || (estimates[a] == estimates[b] && a < b);
+    });
+}
+
+/**
+ * Branch and bound over the rotations: the count first ones of orderRotations are visited in its order, and the row
+ * measures of a rotation stop being added as soon as its partial cost exceeds the best cost so far, the threshold at
+ * the start (the row measures are never negative). measure(i, j, mirrored) is the r measure of row i of the first
+ * signature against row j of the second one, or of its mirror. Ties go to the lowest rotation, the direct orientation
+ * first, as in match.
+ */
+template<typename Measure>
+cpsMatch CpsMatcher::abandon(int n, int count, double threshold, const Measure& measure) {
+    cpsMatch result;
+    result.rotationIndex = -1;
+    result.cost = threshold;
+    result.mirrored = false;
+    int best = -1;
+    for(int r = 0; r < count; r++) {
+        const int rotation = order[r];
+        const int k = rotation % n;
+        const bool mirrored = rotation >= n;
+        CompensatedSum cost;
+        int i = 0;
+        for(; i < n && cost.sum <= result.cost; i++) {
+            cost.add(measure(i, (i + k < n) ? i + k : i + k - n, mirrored));
+        }
+        if(i < n || cost.sum > result.cost) {
+            continue;
+        }
+        if(cost.sum < result.cost || (best >= 0 && rotation < best)) {
+            best = rotation;
+            result.rotationIndex = k;
+            result.cost = cost.sum;
+            result.mirrored = mirrored;
+        }
+    }
+    return result;
+}
+
+/**
+ * Same best rotation and cost as match(mta, mtb), but only if its cost is below threshold; otherwise the rotation
+ * index is -1 and the cost is the threshold. Most rotations are abandoned after a few rows (see abandon), so this is
+ * the matcher for retrieval: in a database scan, the threshold is the cost of the current k-th nearest signature.
+ * Empty signatures match as in match: rotation 0, at no cost.
+ */
+cpsMatch CpsMatcher::matchEarlyAbandon(const CpsRows& mta, const CpsRows& mtb, double threshold) {
+    const int n = mta.rows();
+    const RMeasureInv measureInv = rMeasureInvKernel(n);
+    const cvx::Kernels_<real_t>& kernels = cvx::kernels<real_t>();
+    if(n == 0) {
+        cpsMatch empty = {0, 0, false};
+        return empty;
+    }
+    orderRotations(mta, mtb, false);
+    if(mta.hasReciprocals() && mtb.hasReciprocals()) {
+        return abandon(n, n, threshold, [&](int i, int j, bool) {
+            return measureInv(mta.row(i), mta.reciprocal(i), mtb.row(j), mtb.reciprocal(j), n);
+        });
+    }
+    return abandon(n, n, threshold, [&](int i, int j, bool) {
+        return kernels.r_measure(mta.row(i), mtb.row(j), n);
+    });
+}
+
+/**
+ * Best rotation and cost of mta against both orientations of mtb: the rotations of mtb and those of its mirror, the
+ * signature of the same contour traced in the opposite direction (see CpsRows::mirror). The mirror and its reciprocals
+ * are built in the workspace on every call; when mtb is matched more than once, build it once with CpsRows::mirror and
+ * use matchBothOrientations(mta, mtb, mirrorB, threshold).
+ */
+cpsMatch CpsMatcher::matchBothOrientations(const CpsRows& mta, const CpsRows& mtb, double threshold) {
+    mtb.mirror(mirror);
+    return matchBothOrientations(mta, mtb, mirror, threshold);
+}
+
+/**
+ * Same as matchBothOrientations(mta, mtb, threshold), with the mirror of mtb built by the caller. The rotations of both
+ * orientations are visited in one branch and bound (see abandon): the orientation of the most promising rotation
+ * first, so the other one is bounded by its result from its first row on. The result tells which orientation won, and
+ * has rotation index -1 if no rotation costs less than threshold.
+ */
+cpsMatch CpsMatcher::matchBothOrientations(const CpsRows& mta, const CpsRows& mtb, const CpsRows& mirrorB,
+                                           double threshold) {
+    const int n = mta.rows();
+    const RMeasureInv measureInv = rMeasureInvKernel(n);
+    const cvx::Kernels_<real_t>& kernels = cvx::kernels<real_t>();
+    orderRotations(mta, mtb, true);
+    const bool mirroredFirst = n > 0 && order[0] >= n;
+    std::stable_partition(order.begin(), order.end(), [&](int rotation) { return (rotation >= n) == mirroredFirst; });
+    if(mta.hasReciprocals() && mtb.hasReciprocals() && mirrorB.hasReciprocals()) {
+        return abandon(n, 2 * n, threshold, [&](int i, int j, bool mirrored) {
+            const CpsRows& rows = mirrored ? mirrorB : mtb;
+            return measureInv(mta.row(i), mta.reciprocal(i), rows.row(j), rows.reciprocal(j), n);
+        });
+    }
+    return abandon(n, 2 * n, threshold, [&](int i, int j, bool mirrored) {
+        const CpsRows& rows = mirrored ? mirrorB : mtb;
+        return kernels.r_measure(mta.row(i), rows.row(j), n);
+    });
+}
+
+/**
+ * Coarse to fine search over the rotations: the rows 0, rowStep, 2 rowStep, ... score every rotation, and only the
+ * best scored ones and their neighbours get the full cost, added as in match. With the exact option, the remaining
+ * rotations are then matched with early abandon against that cost, which corrects the result when the coarse scores
+ * missed the best rotation (it is rare, and only costs the rows needed to discard each rotation).
+ */
+template<typename Measure>
+cpsMatch CpsMatcher::coarseToFine(int n, const CoarseToFineOptions& options, const Measure& measure) {
+    const int step = options.rowStep;
+    prepare(n);
+    for(int i = 0; i < n; i += step) {
+        for(int j = 0; j < n; j++) {
+            int k = (j >= i) ? j - i : j - i + n;
+            costs[k].add(measure(i, j));
+        }
+    }
+    const int candidates = std::min(options.candidates, n);
+    order.resize(n);
+    for(int k = 0; k < n; k++) {
+        order[k] = k;
+    }
+    std::partial_sort(order.begin(), order.begin() + candidates, order.end(), [&](int a, int b) {
+        return costs[a].sum < costs[b].sum || (costs[a].sum == costs[b].sum && a < b);
+    });
+
+    /* full cost of the candidates and their neighbours*/
+    measured.assign(n, 0);
+    cpsMatch result;
+    result.rotationIndex = -1;
+    result.cost = 0;
+    result.mirrored = false;
+    for(int c = 0; c < candidates; c++) {
+        for(int d = -options.neighbours; d <= options.neighbours; d++) {
+            int k = ((order[c] + d) % n + n) % n;
+            if(measured[k]) {
+                continue;
+            }
+            measured[k] = 1;
+            CompensatedSum cost;
+            for(int i = 0; i < n; i++) {
+                cost.add(measure(i, (i + k < n) ? i + k : i + k - n));
+            }
+            if(result.rotationIndex < 0 || cost.sum < result.cost
+               || (cost.sum == result.cost && k < result.rotationIndex)) {
+                result.rotationIndex = k;
+                result.cost = cost.sum;
+            }
+        }
+    }
+    if(!options.exact) {
+        return result;
+    }
+
+    /* the other rotations can only replace the result by beating it*/
+    statistics.verified++;
+    int found = result.rotationIndex;
+    for(int k = 0; k < n; k++) {
+        if(measured[k]) {
+            continue;
+        }
+        CompensatedSum cost;
+        int i = 0;
+        for(; i < n && cost.sum <= result.cost; i++) {
+            cost.add(measure(i, (i + k < n) ? i + k : i + k - n));
+        }
+        if(i == n && (cost.sum < result.cost || (cost.sum == result.cost && k < result.rotationIndex))) {
+            result.rotationIndex = k;
+            result.cost = cost.sum;
+        }
+    }
+    if(result.rotationIndex == found) {
+        statistics.agreed++;
+    }
+    return result;
+}
+
+/**
+ * Best rotation and cost of mta against mtb from a coarse to fine search (see coarseToFine): n/rowStep rows per
+ * rotation, then all the rows for a few of them. The result is the one of match in the vast majority of cases, and
+ * always with the exact option; coarseToFineStatistics reports how often the search alone was right.
+ */
+cpsMatch CpsMatcher::matchCoarseToFine(const CpsRows& mta, const CpsRows& mtb, const CoarseToFineOptions& options) {
+    CV_Assert(options.rowStep > 0 && options.candidates > 0 && options.neighbours >= 0);
+    const int n = mta.rows();
+    const RMeasureInv measureInv = rMeasureInvKernel(n);
+    const cvx::Kernels_<real_t>& kernels = cvx::kernels<real_t>();
+    if(n == 0) {
+        cpsMatch empty = {0, 0, false};
+        return empty;
+    }
+    if(mta.hasReciprocals() && mtb.hasReciprocals()) {
+        return coarseToFine(n, options, [&](int i, int j) {
+            return measureInv(mta.row(i), mta.reciprocal(i), mtb.row(j), mtb.reciprocal(j), n);
+        });
+    }
+    return coarseToFine(n, options, [&](int i, int j) {
+        return kernels.r_measure(mta.row(i), mtb.row(j), n);
+    });
+}
+
+/**
+ * Dynamic time warping of the rows of the first signature against those of the second one from the given rotation
+ * on: the cheapest monotone path from (0, 0) to (n-1, n-1), with steps right, down and diagonal, where cell (i, j)
+ * costs measure(i, (j + rotation) % n), and only cells with |i - j| <= band are visited (Sakoe-Chiba band). Returns
+ * infinity as soon as every cell of a row costs more than bound, since no path through it can end below it.
+ */
+template<typename Measure>
+double CpsMatcher::warp(int n, int band, int rotation, double bound, const Measure& measure) {
+    const double infinity = std::numeric_limits<double>::infinity();
+    previousRow.assign(n, infinity);
+    currentRow.assign(n, infinity);
+    for(int i = 0; i < n; i++) {
+        const int lo = std::max(i - band, 0), hi = std::min(i + band, n - 1);
+        double rowMinimum = infinity;
+        for(int j = lo; j <= hi; j++) {
+            double best = (i == 0 && j == 0) ? 0 : infinity;
+            if(i > 0) {
+                best = std::min(best, previousRow[j]);
+                if(j > 0) {
+                    best = std::min(best, previousRow[j - 1]);
+                }
+            }
+            if(j > lo) {
+                best = std::min(best, currentRow[j - 1]);
+            }
+            int m = (j + rotation < n) ? j + rotation : j + rotation - n;
+            currentRow[j] = best + measure(i, m);
+            rowMinimum = std::min(rowMinimum, currentRow[j]);
+        }
+        if(rowMinimum > bound) {
+            return infinity;
+        }
+        previousRow.swap(currentRow);
+    }
+    return previousRow[n - 1];
+}
+
+/**
+ * Elastic matching of two signatures, for shapes with parts that bend or stretch: instead of pairing row i of mta with
+ * row (i+k)%n of mtb, the rows are aligned by cyclic dynamic time warping (see warp) for each starting rotation k,
+ * and the result is the best rotation and its warping cost. Each row pair cost is computed at most once and kept in
+ * the workspace, so the band bounds the row comparisons to O(n * band) per rotation and n^2 in total.
+ * Rotations are visited most promising first and abandoned against the best cost so far, the threshold at the start.
+ * With the euclidean cost, which is the row distance of matchL2, they are ordered by an LB_Keogh lower bound on the
+ * row norms: any path visits every row i of mta in a cell within the band, which costs at least the distance from
+ * |a_i| to the range of |b_j| over the band, so the search stops at the first rotation whose bound is above the best
+ * cost. The r measure has no such bound: the rotations are only ordered as in matchEarlyAbandon, every one of them is
+ * warped, and only the abandoning inside warp saves work. The rotation index is -1 if no rotation costs less than the
+ * threshold.
+ */
+cpsMatch CpsMatcher::matchElastic(const CpsRows& mta, const CpsRows& mtb, const ElasticOptions& options) {
+    const int n = mta.rows();
+    const RMeasureInv measureInv = rMeasureInvKernel(n);
+    const int band = std::min(std::max(options.band, 0), std::max(n - 1, 0));
+    const bool inverse = mta.hasReciprocals() && mtb.hasReciprocals();
+    const cvx::Kernels_<real_t>& kernels = cvx::kernels<real_t>();
+
+    cpsMatch result;
+    result.rotationIndex = -1;
+    result.cost = options.threshold;
+    result.mirrored = false;
+    if(n == 0) {
+        return result;
+    }
+
+    /* row pair costs, computed on demand; negative means not computed yet*/
+    pairCosts.setConstant(n, n, -1);
+    auto measure = [&](int i, int m) {
+        real_t& cost = pairCosts(i, m);
+        if(cost < 0) {
+            const real_t* a = mta.row(i);
+            const real_t* b = mtb.row(m);
+            if(options.l2) {
+                cost = (mta.matrix().row(i) - mtb.matrix().row(m)).norm();
+            } else if(inverse) {
+                cost = measureInv(a, mta.reciprocal(i), b, mtb.reciprocal(m), n);
+            } else {
+                cost = kernels.r_measure(a, b, n);
+            }
+        }
+        return cost;
+    };
+
+    if(options.l2) {
+        normsA = mta.matrix().rowwise().norm();
+        normsB = mtb.matrix().rowwise().norm();
+        estimates.assign(n, 0);
+        for(int k = 0; k < n; k++) {
+            for(int i = 0; i < n; i++) {
+                real_t lower = std::numeric_limits<real_t>::max(), upper = 0;
+                for(int j = std::max(i - band, 0); j <= std::min(i + band, n - 1); j++) {
+                    real_t norm = normsB((j + k) % n);
+                    lower = std::min(lower, norm);
+                    upper = std::max(upper, norm);
+                }
+                real_t norm = normsA(i);
+                estimates[k] += norm > upper ? norm - upper : (norm < lower ? lower - norm : 0);
+            }
+        }
+        order.resize(n);
+        for(int k = 0; k < n; k++) {
+            order[k] = k;
+        }
+        std::sort(order.begin(), order.end(), [&](int a, int b) {
+            return estimates[a] < estimates[b] || (estimates[a] == estimates[b] && a < b);
+        });
+    } else {
+        orderRotations(mta, mtb, false);
+    }
+
+    for(int r = 0; r < n; r++) {
+        const int k = order[r];
+        if(options.l2 && estimates[k] > result.cost) {
+            break;
+        }
+        double cost = warp(n, band, k, result.cost, measure);
+        if(cost < result.cost || (cost == result.cost && result.rotationIndex >= 0 && k < result.rotationIndex)) {
+            result.rotationIndex = k;
+            result.cost = cost;
+        }
+    }
+    return result;
+}
+
+/**
+ * Match two signatures with the euclidean distance between rows instead of the r measure (see matchingCps): the cost
+ * of rotation k is the sum over i of |row i of mta - row (i+k)%n of mtb|.
+ */
+cpsMatch CpsMatcher::matchL2(const CpsRows& mta, const CpsRows& mtb) {
+    return matchL2(mta.matrix(), mtb.matrix());
+}
+
+/**
+ * Same as matchL2(CpsRows, CpsRows) for two signature matrices of the cvx library, read in place.
+ */
+cpsMatch CpsMatcher::matchL2(const cvx::CpsMatrix& mta, const cvx::CpsMatrix& mtb) {
+    CV_Assert(mta.sampling() == mtb.sampling() && mta.definition() == mtb.definition());
+    return matchL2(cpsMatrixRows(mta), cpsMatrixRows(mtb));
+}
+
+/**
+ * Same as matchL2(CpsRows, CpsRows) for any two Eigen matrices of n rows. The squared distance between rows i and j
+ * is |a_i|^2 + |b_j|^2 - 2 a_i.b_j, so all the n x n row products come from a single matrix product A * B^T (a blocked
+ * GEMM in Eigen) and each rotation is a cyclic diagonal of it: O(n^3) multiply-adds at GEMM speed, and O(n^2) for the
+ * diagonals.
+ * The subtraction cancels when two rows are alike, which is the case near the best rotation, so these costs are only
+ * estimates, with a known error bound: the rotations whose estimate could still be the minimum are measured again
+ * row by row, and the result is the same as the direct computation.
+ */
+template<typename MatrixA, typename MatrixB>
+cpsMatch CpsMatcher::matchL2(const Eigen::MatrixBase<MatrixA>& mta, const Eigen::MatrixBase<MatrixB>& mtb) {
+    const int n = mta.rows();
+    if(n == 0) {
+        return bestRotation(0);
+    }
+    normsA = mta.rowwise().squaredNorm();
+    normsB = mtb.rowwise().squaredNorm();
+    products.noalias() = mta * mtb.transpose();
+    cpsMatch estimate = accumulate(n, [&](int i, int j) {
+        real_t squared = normsA(i) + normsB(j) - 2 * products(i, j);
+        return squared > 0 ? std::sqrt(squared) : (real_t)0;
+    });
+
+    /* bound of the error of each estimate: the rounding of a dot product of the row length, through the square root*/
+    const real_t tolerance = 4 * (mta.cols() + 2) * std::numeric_limits<real_t>::epsilon();
+    const real_t maxNormB = normsB.maxCoeff();
+    CompensatedSum bound;
+    for(int i = 0; i < n; i++) {
+        bound.add(std::sqrt(tolerance * (normsA(i) + maxNormB)));
+    }
+
+    cpsMatch result = estimate;
+    bool first = true;
+    for(int k = 0; k < n; k++) {
+        if(costs[k].sum > estimate.cost + 2 * bound.sum) {
+            continue;
+        }
+        CompensatedSum cost;
+        for(int i = 0; i < n; i++) {
+            cost.add((mta.row(i) - mtb.row((i + k) % n)).norm());
+        }
+        if(first || cost.sum < result.cost) {
+            result.rotationIndex = k;
+            result.cost = cost.sum;
+            first = false;
+        }
+    }
+    return result;
+}
+
+
+#endif //CPSWITHSPLINES_CPSMATCHER_H
@@ -0,0 +1,155 @@
+#ifndef CPSWITHSPLINES_CPSROWS_H
+#define CPSWITHSPLINES_CPSROWS_H
+
+#include "main.hpp"
+#include <AlignedAllocator.hpp>
+
+/**
+ * Storage of a cps signature for the matching loops, which read it row by row. Rows are contiguous (row-major), each
+ * one starts on a cache line (CVX_ALIGNMENT bytes) and is padded with zeros up to the next one, so rows can be handed
+ * to the r_measure kernels in place and loaded with aligned, full width SIMD loads.
+ * The reciprocals of the values (1/x) can be stored alongside, with the same layout, so the matching step multiplies
+ * instead of dividing; they are computed once per signature with computeReciprocals, after the values are set. Any
+ * access that can write the values (the non-const row, operator() and matrix) drops them, so stale reciprocals are
+ * never used: computeReciprocals must be called again once the new values are set. set and setRow write values and
+ * keep the reciprocals up to date instead.
+ */
+class CpsRows {
+public:
+    typedef Eigen::Map<RowMatrixXr, Eigen::Unaligned, OuterStride<> > map_t;
+    typedef Eigen::Map<const RowMatrixXr, Eigen::Unaligned, OuterStride<> > const_map_t;
+
+    CpsRows();
+    CpsRows(int rows, int cols);
+    explicit CpsRows(const MatrixXr& matrix);
+
+    void resize(int rows, int cols);
+
+    int rows() const { return rowCount; }
+    int cols() const { return colCount; }
+    /* distance, in values, between the starts of two consecutive rows*/
+    int stride() const { return rowStride; }
+
+    real_t* row(int i) { dropReciprocals(); return &values[(size_t)i * rowStride]; }
+    const real_t* row(int i) const { return &values[(size_t)i * rowStride]; }
+    real_t& operator()(int i, int j) { dropReciprocals(); return values[(size_t)i * rowStride + j]; }
+    real_t operator()(int i, int j) const { return values[(size_t)i * rowStride + j]; }
+    void set(int i, int j, real_t value);
+    void setRow(int i, const real_t* row);
+
+    void computeReciprocals();
+    void mirror(CpsRows& target) const;
+    bool hasReciprocals() const { return inverseValues.size() == values.size(); }
+    const real_t* reciprocal(int i) const { return &inverseValues[(size_t)i * rowStride]; }
+
+    map_t matrix();
+    const_map_t matrix() const;
+    MatrixXr toMatrix() const;
+
+private:
+    /* only clears when there is something to clear, so rows can be written from several threads before computeReciprocals*/
+    void dropReciprocals() { if(!inverseValues.empty()) inverseValues.clear(); }
+
+    std::vector<real_t, cvx::AlignedAllocator_<real_t> > values;
+    std::vector<real_t, cvx::AlignedAllocator_<real_t> > inverseValues;
+    int rowCount;
+    int colCount;
+    int rowStride;
+};
+
+
+CpsRows::CpsRows() : rowCount(0), colCount(0), rowStride(0) {
+}
+
+CpsRows::CpsRows(int rows, int cols) : rowCount(0), colCount(0), rowStride(0) {
+    resize(rows, cols);
+}
+
+CpsRows::CpsRows(const MatrixXr& matrix) : rowCount(0), colCount(0), rowStride(0) {
+    resize(matrix.rows(), matrix.cols());
+    this->matrix() = matrix;
+}
+
+/**
+ * Change the size of the signature. The values are not kept, the padding is zero, and the reciprocals are dropped.
+ */
+void CpsRows::resize(int rows, int cols) {
+    const int lane = CVX_ALIGNMENT / sizeof(real_t);
+    rowCount = rows;
+    colCount = cols;
+    rowStride = (cols + lane - 1) / lane * lane;
+    values.assign((size_t)rows * rowStride, 0);
+    inverseValues.clear();
+}
+
+/**
+ * Store the reciprocals of the current values. The zeros (the last column and the padding) keep a zero reciprocal.
+ */
+void CpsRows::computeReciprocals() {
+    inverseValues.resize(values.size());
+    for(size_t i = 0; i < values.size(); i++) {
+        inverseValues[i] = (values[i] == 0) ? 0 : 1 / values[i];
+    }
+}
+
+/**
+ * Write value (i, j), along with its reciprocal when the reciprocals are stored, so they stay valid.
+ */
+void CpsRows::set(int i, int j, real_t value) {
+    const size_t index = (size_t)i * rowStride + j;
+    values[index] = value;
+    if(hasReciprocals()) {
+        inverseValues[index] = (value == 0) ? 0 : 1 / value;
+    }
+}
+
+/**
+ * Copy the cols() values of row into row i, along with their reciprocals when they are stored, so they stay valid.
+ */
+void CpsRows::setRow(int i, const real_t* row) {
+    for(int j = 0; j < colCount; j++) {
+        set(i, j, row[j]);
+    }
+}
+
+CpsRows::map_t CpsRows::matrix() {
+    dropReciprocals();
+    return map_t(values.empty() ? 0 : &values[0], rowCount, colCount, OuterStride<>(rowStride));
+}
+
+CpsRows::const_map_t CpsRows::matrix() const {
+    return const_map_t(values.empty() ? 0 : &values[0], rowCount, colCount, OuterStride<>(rowStride));
+}
+
+/**
+ * Store in target the signature of the same contour traced in the opposite direction: point i becomes n-1-i, so
+ * value (i, j) becomes (n-1-i, n-2-j), and the last column stays zero. The reciprocals, if any, are moved the same way.
+ */
+void CpsRows::mirror(CpsRows& target) const {
+    const int n = colCount;
+    target.resize(rowCount, colCount);
+    for(int i = 0; i < rowCount; i++) {
+        const real_t* source = row(rowCount - 1 - i);
+        real_t* destination = target.row(i);
+        for(int j = 0; j < n - 1; j++) {
+            destination[j] = source[n - 2 - j];
+        }
+    }
+    if(!inverseValues.empty()) {
+        target.inverseValues.assign(target.values.size(), 0);
+        for(int i = 0; i < rowCount; i++) {
+            const real_t* source = reciprocal(rowCount - 1 - i);
+            real_t* destination = &target.inverseValues[(size_t)i * rowStride];
+            for(int j = 0; j < n - 1; j++) {
+                destination[j] = source[n - 2 - j];
+            }
+        }
+    }
+}
+
+MatrixXr CpsRows::toMatrix() const {
+    return matrix();
+}
+
+
+#endif //CPSWITHSPLINES_CPSROWS_H
@@ -0,0 +1,76 @@
+#ifndef CPSWITHSPLINES_FIXEDCPS_H
+#define CPSWITHSPLINES_FIXEDCPS_H
+
+#include "main.hpp"
+#include "generalFunctions.hpp"
+#include "cpsRows.hpp"
+
+template<int N, typename DistanceFunction>
+void computeCpsFixedSize(const std::vector<cv::Point>& contourPoints, real_t normalization, const DistanceFunction& distance, CpsRows& cps);
+template<typename DistanceFunction>
+bool computeCpsFixed(const std::vector<cv::Point>& contourPoints, real_t normalization, const DistanceFunction& distance, CpsRows& cps);
+
+typedef real_t (*RMeasureInv)(const real_t* X, const real_t* invX, const real_t* Y, const real_t* invY, unsigned n);
+RMeasureInv rMeasureInvKernel(int n);
+
+
+/**
+ * Same values as computeCps for exactly N points. The coordinates are stored twice in a row, so row i is a single
+ * batch of N-1 distances from point i to the points i+1 ... i+N-1, and every loop has a compile-time bound. Only the
+ * coordinates live on the stack: the signature is written in place into its CpsRows storage, which is heap allocated
+ * and cache line aligned for every N, so no fixed-size copy of it is made.
+ */
+template<int N, typename DistanceFunction>
+void computeCpsFixedSize(const std::vector<cv::Point>& contourPoints, real_t normalization, const DistanceFunction& distance, CpsRows& cps) {
+    real_t xs[2 * N], ys[2 * N];
+    for(int i = 0; i < N; i++) {
+        xs[i] = xs[i + N] = contourPoints[i].x;
+        ys[i] = ys[i + N] = contourPoints[i].y;
+    }
+
+    cps.resize(N, N);
+    for(int i = 0; i < N; i++) {
+        real_t* row = cps.row(i);
+        distance.batch(cvx::Point2r(xs[i], ys[i]), xs + i + 1, ys + i + 1, row, N - 1);
+        for(int j = 0; j < N - 1; j++) {
+            row[j] = (row[j] == 0 ? 1 : row[j]) * normalization;
+        }
+        row[N - 1] = 0;
+    }
+}
+
+/**
+ * Compute the signature with the fixed-size kernel when the number of points is one of the common sample counts
+ * (16, 32, 64, 128 or 256). Returns false, leaving cps untouched, for any other size.
+ */
+template<typename DistanceFunction>
+bool computeCpsFixed(const std::vector<cv::Point>& contourPoints, real_t normalization, const DistanceFunction& distance, CpsRows& cps) {
+    switch(contourPoints.size()) {
+        case 16: computeCpsFixedSize<16>(contourPoints, normalization, distance, cps); return true;
+        case 32: computeCpsFixedSize<32>(contourPoints, normalization, distance, cps); return true;
+        case 64: computeCpsFixedSize<64>(contourPoints, normalization, distance, cps); return true;
+        case 128: computeCpsFixedSize<128>(contourPoints, normalization, distance, cps); return true;
+        case 256: computeCpsFixedSize<256>(contourPoints, normalization, distance, cps); return true;
+        default: return false;
+    }
+}
+
+/**
+ * The r_measure_inv kernel for rows of n values: the one compiled for n when it is one of the common sample counts
+ * (16, 32, 64, 128 or 256), the general one otherwise. Both give the same results. The matching loops look it up once
+ * per signature pair.
+ */
+RMeasureInv rMeasureInvKernel(int n) {
+    const cvx::Kernels_<real_t>& kernels = cvx::kernels<real_t>();
+    switch(n) {
+        case 16: return kernels.r_measure_inv_fixed[0];
+        case 32: return kernels.r_measure_inv_fixed[1];
+        case 64: return kernels.r_measure_inv_fixed[2];
+        case 128: return kernels.r_measure_inv_fixed[3];
+        case 256: return kernels.r_measure_inv_fixed[4];
+        default: return kernels.r_measure_inv;
+    }
+}
+
+
+#endif //CPSWITHSPLINES_FIXEDCPS_H
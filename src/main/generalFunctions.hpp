@@ -13,21 +13,38 @@ cv::Point2d minSum(cv::Mat mat);
 int getNext(int x, int y, int last, cv::Mat data, int totalRows, int totalCols);
 double getMaxMinValue(std::vector<double> vector,std::string valueType);
 
+/**
+ * Running sum with Kahan compensation: the low order bits lost in each addition are carried into the next one, so
+ * long sums keep their accuracy when real_t is float.
+ */
+struct CompensatedSum {
+    real_t sum;
+    real_t compensation;
+
+    CompensatedSum() : sum(0), compensation(0) {}
+
+    void add(real_t value) {
+        real_t y = value - compensation;
+        real_t t = sum + y;
+        compensation = (t - sum) - y;
+        sum = t;
+    }
+};
 
 /**
  *
  * This method is used to get the column that has the minum sum value(saved in X) and the index of that column(saved on Y).
  * X is the result value of the metric dist_1.
  */
-cv::Point2d minSum(MatrixXd mat) {
+cv::Point2d minSum(const MatrixXr& mat) {
     /*We get the sum of the values for each column*/
     std::vector<double> vector;
-    for(double j = 0; j <  mat.cols(); j++) {
-        double sum = 0 ;
-        for (double i = 0 ; i < mat.rows() ; i++) {
-            sum += mat(i,j);
+    for(int j = 0; j <  mat.cols(); j++) {
+        CompensatedSum sum;
+        for (int i = 0 ; i < mat.rows() ; i++) {
+            sum.add(mat(i,j));
         }
-        vector.push_back(sum);
+        vector.push_back(sum.sum);
     }
     /*We get the minum value in the vector and the index of that value which represents the column of the matrix with the minum value*/
     double min = vector[0];
@@ -0,0 +1,60 @@
+#ifndef CPSWITHSPLINES_GEODESICCPS_H
+#define CPSWITHSPLINES_GEODESICCPS_H
+
+#include "main.hpp"
+#include "cpsFunctions.hpp"
+#include "tiledCps.hpp"
+#include <DistanceGeodesic.hpp>
+
+cvx::PlanarSet getContourShape(const std::vector<cv::Point>& contourPoints);
+cspResult computeGeodesicCps(const std::vector<cv::Point>& contourPoints, const double area, const cvx::PlanarSet& shape, int threads = 0);
+
+
+/**
+ * Inside of a closed contour (the contour included) as a planar set, covering only its bounding rectangle.
+ */
+cvx::PlanarSet getContourShape(const std::vector<cv::Point>& contourPoints) {
+    cv::Rect box = cv::boundingRect(contourPoints);
+    cv::Mat mask = cv::Mat::zeros(box.height, box.width, CV_8U);
+    std::vector<std::vector<cv::Point> > polygons(1, contourPoints);
+    cv::fillPoly(mask, polygons, cv::Scalar(255), 8, 0, cv::Point(-box.x, -box.y));
+    return cvx::PlanarSet(mask, cv::Point(box.x, box.y));
+}
+
+/**
+ * Create the cps signature for a specific contour with the geodesic (inner) distance within shape instead of the
+ * euclidean one, i.e., the same as computeCps(contourPoints, area, cvx::DistanceGeodesic(shape)).
+ * Each row takes one fast marching sweep from its point. Rows are distributed across threads, and each thread
+ * reuses a single distance map, so the memory used is O(threads * shape pixels) besides the signature.
+ */
+cspResult computeGeodesicCps(const std::vector<cv::Point>& contourPoints, const double area, const cvx::PlanarSet& shape, int threads) {
+    cspResult R;
+    int n = contourPoints.size();
+    real_t normalization = 1 / sqrt(area);
+    R.CPSMatrix.resize(n, n);
+
+    std::vector<real_t> xs(n), ys(n);
+    for(int i = 0; i < n; i++) {
+        xs[i] = contourPoints[i].x;
+        ys[i] = contourPoints[i].y;
+    }
+
+    const cvx::DistanceGeodesic geodesic(shape);
+    std::atomic<int> next(0);
+    threads = std::min(getCpsThreadCount(threads), std::max(n, 1));
+
+    /* one worker per thread, each one with its own distance map; rows are written in place*/
+    runCpsWorkers(threads, threads, [&](int) {
+        cvx::DistanceGeodesic distance(geodesic);
+        for(int i = next++; i < n; i = next++) {
+            computeCpsRow(distance, &xs[0], &ys[0], n, i, normalization, R.CPSMatrix.row(i));
+        }
+    });
+    R.CPSMatrix.computeReciprocals();
+
+    R.pointSample = contourPoints;
+    return R;
+}
+
+
+#endif //CPSWITHSPLINES_GEODESICCPS_H
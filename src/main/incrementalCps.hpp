@@ -0,0 +1,183 @@
+#ifndef CPSWITHSPLINES_INCREMENTALCPS_H
+#define CPSWITHSPLINES_INCREMENTALCPS_H
+
+#include "main.hpp"
+#include "cpsFunctions.hpp"
+
+/**
+ * CPS signature of a contour that is kept up to date when only some of its sample points move (e.g. tracking).
+ * The matrix holds the same values computeCps would produce, stored row by row with their reciprocals (see
+ * CpsRows::set), together with the row sums.
+ * Updating k points costs O(n*k) instead of the O(n^2) of a full computeCps. The row sums are compensated running
+ * sums (see CompensatedSum), recomputed from the row after every n updates of it, which is O(1) per update on
+ * average: they stay within a small multiple of the rounding error of the sum of the row, however many frames are
+ * tracked.
+ */
+class IncrementalCps {
+public:
+    IncrementalCps(const std::vector<cv::Point>& contourPoints, const double area);
+
+    void update(const std::vector<int>& changedIndices, const std::vector<cv::Point>& newPoints);
+    void rebuild();
+
+    int size() const { return (int)points.size(); }
+    const CpsRows& matrix() const { return cps; }
+    const VectorXr& rowSums() const { return sums; }
+    const std::vector<cv::Point>& pointSample() const { return points; }
+    cspResult result() const;
+
+private:
+    real_t distance(int i, int j) const;
+    void computeRow(int i);
+    void setValue(int i, int j, real_t value);
+    void computeSum(int i);
+
+    std::vector<cv::Point> points;
+    std::vector<real_t> xs, ys;
+    real_t normalization;
+    CpsRows cps;
+    std::vector<real_t> row;
+    std::vector<CompensatedSum> totals;
+    std::vector<int> updates;
+    VectorXr sums;
+    std::vector<char> changed;
+};
+
+std::vector<double> getPointMatchingCost(const IncrementalCps& A, const IncrementalCps& B);
+
+
+IncrementalCps::IncrementalCps(const std::vector<cv::Point>& contourPoints, const double area)
+        : points(contourPoints), normalization(1 / sqrt(area)) {
+    rebuild();
+}
+
+/**
+ * Recompute the whole signature, the row sums and the reciprocals from the current points.
+ */
+void IncrementalCps::rebuild() {
+    int n = size();
+    xs.resize(n);
+    ys.resize(n);
+    for(int i = 0; i < n; i++) {
+        xs[i] = points[i].x;
+        ys[i] = points[i].y;
+    }
+    /* zero values and their zero reciprocals, kept up to date from here on*/
+    cps.resize(n, n);
+    cps.computeReciprocals();
+    row.resize(n);
+    totals.resize(n);
+    updates.resize(n);
+    sums.resize(n);
+    changed.assign(n, 0);
+    for(int i = 0; i < n; i++) {
+        computeRow(i);
+    }
+}
+
+/**
+ * Distance between the points i and j, with the same rules as computeCps: 0 on the diagonal, and coincident
+ * points are considered at distance 1.
+ */
+real_t IncrementalCps::distance(int i, int j) const {
+    if(i == j) {
+        return 0;
+    }
+    real_t d = cvx::DistanceEuclidean()(points[i], points[j]);
+    return d == 0 ? 1 : d;
+}
+
+/**
+ * Row i holds the distances from point i to the points i+1, i+2, ... (rotated i+1 places to the left).
+ */
+void IncrementalCps::computeRow(int i) {
+    computeCpsRow(cvx::DistanceEuclidean(), &xs[0], &ys[0], size(), i, normalization, &row[0]);
+    cps.setRow(i, &row[0]);
+    computeSum(i);
+}
+
+/**
+ * Sum of row i from its values, compensated.
+ */
+void IncrementalCps::computeSum(int i) {
+    const real_t* values = matrix().row(i);
+    totals[i] = CompensatedSum();
+    for(int j = 0; j < size(); j++) {
+        totals[i].add(values[j]);
+    }
+    updates[i] = 0;
+    sums(i) = totals[i].sum;
+}
+
+/**
+ * Replace value (i, j). The old value leaves the running sum of the row and the new one enters it as two
+ * compensated terms, so their difference is not rounded; the sum is recomputed after n updates of the row.
+ */
+void IncrementalCps::setValue(int i, int j, real_t value) {
+    const real_t old = matrix()(i, j);
+    cps.set(i, j, value);
+    if(++updates[i] >= size()) {
+        computeSum(i);
+        return;
+    }
+    totals[i].add(value);
+    totals[i].add(-old);
+    sums(i) = totals[i].sum;
+}
+
+/**
+ * Move the points in changedIndices to newPoints. Only the rows of the moved points are recomputed; every other
+ * row has a single entry (its distance to each moved point) updated.
+ */
+void IncrementalCps::update(const std::vector<int>& changedIndices, const std::vector<cv::Point>& newPoints) {
+    CV_Assert(changedIndices.size() == newPoints.size());
+    int n = size();
+
+    for(int c = 0; c < changedIndices.size(); c++) {
+        points[changedIndices[c]] = newPoints[c];
+        xs[changedIndices[c]] = newPoints[c].x;
+        ys[changedIndices[c]] = newPoints[c].y;
+        changed[changedIndices[c]] = 1;
+    }
+
+    for(int c = 0; c < changedIndices.size(); c++) {
+        int k = changedIndices[c];
+        for(int i = 0; i < n; i++) {
+            /* rows of moved points are fully recomputed below*/
+            if(!changed[i]) {
+                setValue(i, (k - i - 1 + n) % n, distance(i, k) * normalization);
+            }
+        }
+    }
+
+    for(int c = 0; c < changedIndices.size(); c++) {
+        int k = changedIndices[c];
+        if(changed[k]) {
+            computeRow(k);
+            changed[k] = 0;
+        }
+    }
+}
+
+cspResult IncrementalCps::result() const {
+    cspResult R;
+    R.CPSMatrix = cps;
+    R.pointSample = points;
+    return R;
+}
+
+/**
+ * Same as getPointMatchingCost(CpsRows, CpsRows), with the reciprocals kept up to date by the updates.
+ */
+std::vector<double> getPointMatchingCost(const IncrementalCps& A, const IncrementalCps& B) {
+    CpsMatcher matcher;
+    cpsMatch match = matcher.match(A.matrix(), B.matrix());
+
+    std::vector<double> result;
+    result.push_back(match.rotationIndex);
+    result.push_back(match.cost);
+    return result;
+}
+
+
+#endif //CPSWITHSPLINES_INCREMENTALCPS_H
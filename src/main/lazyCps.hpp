@@ -0,0 +1,128 @@
+#ifndef CPSWITHSPLINES_LAZYCPS_H
+#define CPSWITHSPLINES_LAZYCPS_H
+
+#include "main.hpp"
+#include "cpsFunctions.hpp"
+#include <list>
+
+/**
+ * CPS signature of a contour that only keeps the sampled points and the normalization. Rows are generated on demand,
+ * with the same values as computeCps, into a small pool of reusable buffers; the most recently used rows are kept in
+ * the pool (LRU), so the memory is O(cachedRows * n) instead of O(n^2).
+ */
+class LazyCps {
+public:
+    LazyCps(const std::vector<cv::Point>& contourPoints, const double area, int cachedRows = 8);
+
+    int size() const { return (int)xs.size(); }
+    int cachedRows() const { return (int)buffers.size(); }
+    long generatedRows() const { return generated; }
+    const real_t* row(int i);
+
+private:
+    std::vector<real_t> xs, ys;
+    real_t normalization;
+    std::vector<std::vector<real_t> > buffers;
+    /* most recently used first, each entry is a buffer index*/
+    std::list<int> recent;
+    std::vector<std::list<int>::iterator> position;
+    std::vector<int> cachedRow;
+    std::vector<int> bufferOfRow;
+    long generated;
+};
+
+std::vector<double> getPointMatchingCost(LazyCps& A, LazyCps& B);
+
+
+LazyCps::LazyCps(const std::vector<cv::Point>& contourPoints, const double area, int cachedRows)
+        : normalization(1 / sqrt(area)), generated(0) {
+    int n = contourPoints.size();
+    for(int i = 0; i < n; i++) {
+        xs.push_back(contourPoints[i].x);
+        ys.push_back(contourPoints[i].y);
+    }
+    /* at least one buffer, none for an empty contour*/
+    cachedRows = std::max(std::min(cachedRows, n), std::min(n, 1));
+    buffers.assign(cachedRows, std::vector<real_t>(n));
+    cachedRow.assign(cachedRows, -1);
+    bufferOfRow.assign(n, -1);
+    for(int b = 0; b < cachedRows; b++) {
+        recent.push_back(b);
+    }
+    for(std::list<int>::iterator it = recent.begin(); it != recent.end(); ++it) {
+        position.push_back(it);
+    }
+}
+
+/**
+ * Row i of the signature. The returned pointer is valid until cachedRows() other rows have been requested.
+ */
+const real_t* LazyCps::row(int i) {
+    int b = bufferOfRow[i];
+    if(b < 0) {
+        /* reuse the least recently used buffer*/
+        b = recent.back();
+        if(cachedRow[b] >= 0) {
+            bufferOfRow[cachedRow[b]] = -1;
+        }
+        cachedRow[b] = i;
+        bufferOfRow[i] = b;
+
+        computeCpsRow(cvx::DistanceEuclidean(), &xs[0], &ys[0], size(), i, normalization, &buffers[b][0]);
+        generated++;
+    }
+    recent.splice(recent.begin(), recent, position[b]);
+    return &buffers[b][0];
+}
+
+/**
+ * This method get the distance between two lazy cps signatures: the same rotation as getPointMatchingCost and, up to
+ * rounding, the same cost (the rows are divided here, while the eager signatures are matched with their reciprocals).
+ * Rows of A are taken in blocks as large as its cache, and all rows of B are swept once per block, so A rows are
+ * generated once and B rows n / A.cachedRows() times: the cache size trades memory for recomputation. Each block of
+ * A is copied out of its cache, since the rows of B may evict it (A and B can be the same signature).
+ */
+std::vector<double> getPointMatchingCost(LazyCps& A, LazyCps& B) {
+    std::vector<double> result;
+    int n = A.size();
+    if(n == 0) {
+        /* empty signatures: rotation 0, at no cost, as CpsMatcher::match*/
+        result.push_back(0);
+        result.push_back(0);
+        return result;
+    }
+    int block = A.cachedRows();
+    std::vector<CompensatedSum> sums(n);
+    std::vector<real_t> rowsA((size_t)block * n);
+
+    for(int i0 = 0; i0 < n; i0 += block) {
+        int i1 = std::min(i0 + block, n);
+        for(int i = i0; i < i1; i++) {
+            const real_t* X = A.row(i);
+            std::copy(X, X + n, &rowsA[(size_t)(i - i0) * n]);
+        }
+        for(int j = 0; j < n; j++) {
+            const real_t* Y = B.row(j);
+            for(int i = i0; i < i1; i++) {
+                /* row i of A against row j of B is rotation k*/
+                int k = j >= i ? j - i : j - i + n;
+                sums[k].add(r_measure(&rowsA[(size_t)(i - i0) * n], Y, n));
+            }
+        }
+    }
+
+    /*the minimum sum over the rotations, as minSum does*/
+    int index = 0;
+    for(int k = 1; k < n; k++) {
+        if(sums[k].sum < sums[index].sum) {
+            index = k;
+        }
+    }
+    result.push_back(index);
+    result.push_back(sums[index].sum);
+
+    return result;
+}
+
+
+#endif //CPSWITHSPLINES_LAZYCPS_H
@@ -8,6 +8,10 @@
 /*CPS libraries*/
 #include <CpSignature.hpp>
 #include <CpsMatrix.hpp>
+#include <DistanceL1.hpp>
+#include <DistanceL2.hpp>
+#include <DistanceLinf.hpp>
+#include <Kernels.hpp>
 /*common files*/
 #include <iostream>
 #include <Eigen/Sparse>
@@ -29,6 +33,14 @@ using namespace Eigen;
 
 typedef Eigen::SparseMatrix<double> sMatrix;
 
+/*Floating point type of the cps signatures and of the matching, it follows CVX_DEFAULT_FLOAT (double unless the
+ build defines CVX_DEFAULT_FLOAT=CV_32F)*/
+typedef cvx::Real real_t;
+typedef Eigen::Matrix<real_t, Dynamic, Dynamic> MatrixXr;
+typedef Eigen::Matrix<real_t, Dynamic, Dynamic, RowMajor> RowMatrixXr;
+typedef Eigen::Matrix<real_t, Dynamic, 1> VectorXr;
+typedef Eigen::Matrix<real_t, 1, Dynamic> RowVectorXr;
+
 
 int dx[8] = {-1, -1, 0, 1, 1, 1, 0, -1};
 int dy[8] = {0, 1, 1, 1, 0, -1, -1, -1};
@@ -38,15 +50,15 @@ typedef struct classResults {
     std::string class_name;
     std::vector<cv::Mat> images;
 
-    std::vector<MatrixXd> cp_signatures_32; // n
+    std::vector<MatrixXr> cp_signatures_32; // n
     std::vector<double> same_class_distances_32; // (n-1) / 2
     std::vector<double> diff_class_distances_32; // (n-1) / 2
 
-    std::vector<MatrixXd> cp_signatures_64;
+    std::vector<MatrixXr> cp_signatures_64;
     std::vector<double> same_class_distances_64;
     std::vector<double> diff_class_distances_64;
 
-    std::vector<MatrixXd> cp_signatures_128;
+    std::vector<MatrixXr> cp_signatures_128;
     std::vector<double> same_class_distances_128;
     std::vector<double> diff_class_distances_128;
 
@@ -0,0 +1,119 @@
+#ifndef CPSWITHSPLINES_METRICREGISTRY_H
+#define CPSWITHSPLINES_METRICREGISTRY_H
+
+#include "main.hpp"
+#include "cpsFunctions.hpp"
+#include <map>
+#include <sstream>
+#include <string>
+
+/**
+ * Builds the cps signature of a contour with one distance functor, as computeCps(contourPoints, area, distance).
+ */
+typedef cspResult (*CpsBuilder)(const std::vector<cv::Point>& contourPoints, const double area);
+
+template<typename DistanceFunction>
+cspResult computeCpsFor(const std::vector<cv::Point>& contourPoints, const double area);
+std::map<std::string, CpsBuilder> makeDefaultCpsMetrics();
+std::map<std::string, CpsBuilder>& getCpsMetrics();
+template<typename DistanceFunction>
+void registerCpsMetric(const std::string& name);
+template<unsigned int P>
+void registerCpsLpMetric();
+std::vector<std::string> getCpsMetricNames();
+CpsBuilder getCpsBuilder(const std::string& metric);
+cspResult computeCpsWithMetric(const std::vector<cv::Point>& contourPoints, const double area, const std::string& metric);
+double similarityMeasureWithMetric(const std::vector<cv::Point>& contourA, const double areaA, const std::vector<cv::Point>& contourB,
+                                   const double areaB, const std::string& metric, double alpha, double beta);
+
+
+/**
+ * The kernel registered for a distance functor: computeCps instantiated for it, so the norm is inlined in the row
+ * loops and the metric is only chosen once per signature.
+ */
+template<typename DistanceFunction>
+cspResult computeCpsFor(const std::vector<cv::Point>& contourPoints, const double area) {
+    return computeCps(contourPoints, area, DistanceFunction());
+}
+
+/**
+ * The metrics the registry starts with: L1, L2, Linf, L3 and L4.
+ */
+std::map<std::string, CpsBuilder> makeDefaultCpsMetrics() {
+    std::map<std::string, CpsBuilder> metrics;
+    metrics["L1"] = &computeCpsFor<cvx::DistanceL1>;
+    metrics["L2"] = &computeCpsFor<cvx::DistanceL2>;
+    metrics["Linf"] = &computeCpsFor<cvx::DistanceLinf>;
+    metrics["L3"] = &computeCpsFor<cvx::Distance_<cvx::NormLp_<3> > >;
+    metrics["L4"] = &computeCpsFor<cvx::Distance_<cvx::NormLp_<4> > >;
+    return metrics;
+}
+
+/**
+ * Registry of the metrics selectable at runtime, by name, filled with makeDefaultCpsMetrics on the first call (a
+ * thread-safe initialization). Looking metrics up is safe from several threads; registering one is not, so register
+ * them before the threads start.
+ */
+std::map<std::string, CpsBuilder>& getCpsMetrics() {
+    static std::map<std::string, CpsBuilder> metrics = makeDefaultCpsMetrics();
+    return metrics;
+}
+
+/**
+ * Make a distance functor selectable by name, replacing any metric registered with the same name.
+ */
+template<typename DistanceFunction>
+void registerCpsMetric(const std::string& name) {
+    getCpsMetrics()[name] = &computeCpsFor<DistanceFunction>;
+}
+
+/**
+ * Make the Lp distance selectable as "L<P>", e.g. registerCpsLpMetric<6>() adds "L6".
+ */
+template<unsigned int P>
+void registerCpsLpMetric() {
+    std::ostringstream name;
+    name << "L" << P;
+    registerCpsMetric<cvx::Distance_<cvx::NormLp_<P> > >(name.str());
+}
+
+std::vector<std::string> getCpsMetricNames() {
+    std::vector<std::string> names;
+    std::map<std::string, CpsBuilder>& metrics = getCpsMetrics();
+    for(std::map<std::string, CpsBuilder>::const_iterator it = metrics.begin(); it != metrics.end(); ++it) {
+        names.push_back(it->first);
+    }
+    return names;
+}
+
+/**
+ * The kernel of a registered metric, an unknown name is an error.
+ */
+CpsBuilder getCpsBuilder(const std::string& metric) {
+    std::map<std::string, CpsBuilder>& metrics = getCpsMetrics();
+    std::map<std::string, CpsBuilder>::const_iterator it = metrics.find(metric);
+    if(it == metrics.end()) {
+        CV_Error(cv::Error::StsBadArg, "Unknown cps metric: " + metric);
+    }
+    return it->second;
+}
+
+/**
+ * Create the cps signature for a specific contour with a metric chosen at runtime. The metric is looked up once,
+ * the whole signature is then built by its kernel.
+ */
+cspResult computeCpsWithMetric(const std::vector<cv::Point>& contourPoints, const double area, const std::string& metric) {
+    return getCpsBuilder(metric)(contourPoints, area);
+}
+
+/**
+ * Same as similarityMeasure, with both signatures built with a metric chosen at runtime.
+ */
+double similarityMeasureWithMetric(const std::vector<cv::Point>& contourA, const double areaA, const std::vector<cv::Point>& contourB,
+                                   const double areaB, const std::string& metric, double alpha, double beta) {
+    CpsBuilder build = getCpsBuilder(metric);
+    return similarityMeasure(build(contourA, areaA), build(contourB, areaB), alpha, beta);
+}
+
+
+#endif //CPSWITHSPLINES_METRICREGISTRY_H
@@ -0,0 +1,126 @@
+#ifndef CPSWITHSPLINES_TILEDCPS_H
+#define CPSWITHSPLINES_TILEDCPS_H
+
+#include "main.hpp"
+#include "cpsFunctions.hpp"
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/**
+ * Receives one finished row of a streamed cps signature: the row index, the row values and the row length.
+ * Rows are delivered one at a time, but not necessarily in order.
+ */
+typedef std::function<void(int, const real_t*, int)> CpsRowSink;
+
+cspResult computeCpsTiled(const std::vector<cv::Point>& contourPoints, const double area, int threads = 0, int tileSize = 32);
+void streamCpsTiled(const std::vector<cv::Point>& contourPoints, const double area, const CpsRowSink& sink, int threads = 0, int bandRows = 64);
+int getCpsThreadCount(int threads);
+void runCpsWorkers(int count, int threads, const std::function<void(int)>& worker);
+
+
+/**
+ * Number of worker threads to use, 0 means one per hardware thread.
+ */
+int getCpsThreadCount(int threads) {
+    if(threads <= 0) {
+        threads = (int)std::thread::hardware_concurrency();
+    }
+    return threads > 0 ? threads : 1;
+}
+
+/**
+ * Run worker(index) for every index in [0, count) over the given number of threads. Indices are handed out one at
+ * a time, so threads that finish early take the remaining work.
+ */
+void runCpsWorkers(int count, int threads, const std::function<void(int)>& worker) {
+    std::atomic<int> next(0);
+    auto loop = [&]() {
+        for(int index = next++; index < count; index = next++) {
+            worker(index);
+        }
+    };
+    std::vector<std::thread> pool;
+    for(int t = 1; t < std::min(threads, count); t++) {
+        pool.push_back(std::thread(loop));
+    }
+    loop();
+    for(int t = 0; t < pool.size(); t++) {
+        pool[t].join();
+    }
+}
+
+/**
+ * Create the cps signature for a specific contour, with the same values as computeCps, for large sample counts.
+ * The rows are computed in bands of tileSize rows, handed out one at a time to the threads, and each row is written
+ * once, front to back, straight into the signature. Computing every pair once and storing it in both of its rows
+ * would halve the distances, but they are a small part of the time, and the second store goes down the columns of the
+ * signature and costs more than it saves.
+ */
+cspResult computeCpsTiled(const std::vector<cv::Point>& contourPoints, const double area, int threads, int tileSize) {
+    cspResult R;
+    int n = contourPoints.size();
+    real_t normalization = 1 / sqrt(area);
+    const cvx::Kernels_<real_t>& kernels = cvx::kernels<real_t>();
+    R.CPSMatrix.resize(n, n);
+    CpsRows& cps = R.CPSMatrix;
+
+    std::vector<real_t> xs(n), ys(n);
+    for(int i = 0; i < n; i++) {
+        xs[i] = contourPoints[i].x;
+        ys[i] = contourPoints[i].y;
+    }
+
+    tileSize = std::max(tileSize, 1);
+    int bands = (n + tileSize - 1) / tileSize;
+    runCpsWorkers(bands, getCpsThreadCount(threads), [&](int b) {
+        int i0 = b * tileSize, i1 = std::min(i0 + tileSize, n);
+        for(int i = i0; i < i1; i++) {
+            /* the points after i, then the points before it; the distance to itself goes to the last column*/
+            real_t* row = cps.row(i);
+            kernels.cps_run(xs[i], ys[i], &xs[0] + i + 1, &ys[0] + i + 1, row, n - 1 - i, normalization);
+            kernels.cps_run(xs[i], ys[i], &xs[0], &ys[0], row + n - 1 - i, i, normalization);
+            row[n - 1] = 0;
+        }
+    });
+    cps.computeReciprocals();
+
+    R.pointSample = contourPoints;
+    return R;
+}
+
+/**
+ * Compute the cps signature for a specific contour row by row, and hand each finished row to sink instead of
+ * keeping the whole matrix. Each thread computes bands of bandRows rows into its own buffer, so the memory used is
+ * O(threads * bandRows * n) instead of O(n^2).
+ */
+void streamCpsTiled(const std::vector<cv::Point>& contourPoints, const double area, const CpsRowSink& sink, int threads, int bandRows) {
+    int n = contourPoints.size();
+    real_t normalization = 1 / sqrt(area);
+    cvx::DistanceEuclidean distance;
+
+    std::vector<real_t> xs(n), ys(n);
+    for(int i = 0; i < n; i++) {
+        xs[i] = contourPoints[i].x;
+        ys[i] = contourPoints[i].y;
+    }
+
+    int bands = (n + bandRows - 1) / bandRows;
+    std::mutex sinkMutex;
+
+    runCpsWorkers(bands, getCpsThreadCount(threads), [&](int b) {
+        int i0 = b * bandRows, i1 = std::min(i0 + bandRows, n);
+        std::vector<real_t> band((i1 - i0) * n);
+        for(int i = i0; i < i1; i++) {
+            computeCpsRow(distance, &xs[0], &ys[0], n, i, normalization, &band[(i - i0) * n]);
+        }
+        std::lock_guard<std::mutex> lock(sinkMutex);
+        for(int i = i0; i < i1; i++) {
+            sink(i, &band[(i - i0) * n], n);
+        }
+    });
+}
+
+
+#endif //CPSWITHSPLINES_TILEDCPS_H